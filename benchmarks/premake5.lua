@@ -0,0 +1,69 @@
+project "poly-physx-app-benchmarks"
+staticruntime "off"
+kind "ConsoleApp"
+
+language "C++"
+cppdialect "c++20"
+
+filter "system:macosx or linux"
+   buildoptions {
+      "-Wall",
+      "-Wextra",
+      "-Wpedantic",
+      "-Wconversion",
+      "-Wno-unused-parameter",
+      "-Wno-sign-conversion",
+      "-Wno-gnu-anonymous-struct",
+      "-Wno-nested-anon-types",
+      "-Wno-string-conversion"
+   }
+filter {}
+
+targetdir("bin/" .. outputdir)
+objdir("build/" .. outputdir)
+
+files {
+   "src/**.cpp",
+   "src/**.hpp"
+}
+includedirs {
+   "src",
+   "../include",
+   "%{wks.location}/poly-physx/include",
+   "%{wks.location}/lynx/include",
+   "%{wks.location}/geometry/include",
+   "%{wks.location}/rk-integrator/include",
+   "%{wks.location}/cpp-kit/include",
+   "%{wks.location}/vendor/yaml-cpp/include",
+   "%{wks.location}/vendor/glfw/include",
+   "%{wks.location}/vendor/glm",
+   "%{wks.location}/vendor/imgui",
+   "%{wks.location}/vendor/implot",
+   "%{wks.location}/vendor/spdlog/include"
+}
+links {
+   "poly-physx-app",
+   "poly-physx",
+   "lynx",
+   "geometry",
+   "rk-integrator",
+   "cpp-kit",
+   "yaml-cpp",
+   "glfw",
+   "imgui",
+   "implot"
+}
+VULKAN_SDK = os.getenv("VULKAN_SDK")
+filter "system:windows"
+   includedirs "%{VULKAN_SDK}/Include"
+   links "%{VULKAN_SDK}/Lib/vulkan-1.lib"
+filter "system:macosx or linux"
+   links "vulkan"
+filter "system:macosx"
+   libdirs "%{VULKAN_SDK}/lib"
+   links {
+      "Cocoa.framework",
+      "IOKit.framework",
+      "CoreFoundation.framework"
+   }
+filter {}
@@ -0,0 +1,254 @@
+#include "scenes.hpp"
+#include "report.hpp"
+
+#include "ppx-app/app/app.hpp"
+#include "ppx-app/app/simulation.hpp"
+#include "ppx-app/profiling/frame_profiler.hpp"
+#include "ppx/joints/spring_joint.hpp"
+#include "ppx/joints/distance_joint.hpp"
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ppx::bench
+{
+struct settings
+{
+    std::vector<scene> scenes{all_scenes.begin(), all_scenes.end()};
+    std::vector<std::size_t> counts{100, 500, 1000, 5000};
+    std::size_t warmup = 120;
+    std::size_t frames = frame_profiler::capacity;
+    float timestep = 1.f / 60.f;
+    std::size_t worker_threads = job_pool::default_thread_count();
+    bool windowed = false;
+    std::string output;
+};
+
+// Headless runs cannot draw, so the CPU side of drawing is measured by filling a collider batch with the visible shapes
+class bench_simulation final : public simulation
+{
+  public:
+    using simulation::simulation;
+
+    void on_update(const float ts) override
+    {
+        simulation::on_update(ts);
+        PPX_PROFILE_SCOPE("ppx::bench::batch_shapes")
+        m_batch.clear();
+        for_each_visible_shape([this](const auto &crepr) { crepr.draw(m_batch); }, false);
+    }
+
+  private:
+    collider_batch2D m_batch;
+};
+
+// Windowed runs go through the whole app, including joint updates and the actual draw calls
+class bench_app final : public app
+{
+  public:
+    bench_app(const app::specs &spc, const std::size_t warmup, const std::size_t frames)
+        : app(spc), m_warmup(warmup), m_frames(frames)
+    {
+    }
+
+    void on_update(const float ts) override
+    {
+        if (m_frame_count == m_warmup)
+            frame_profiler::enabled(true);
+        if (m_frame_count++ == m_warmup + m_frames)
+        {
+            shutdown();
+            return;
+        }
+        app::on_update(ts);
+    }
+
+  private:
+    std::size_t m_warmup;
+    std::size_t m_frames;
+    std::size_t m_frame_count = 0;
+};
+
+static std::size_t joint_count(world2D &world)
+{
+    return world.joints.manager<spring_joint2D>()->size() + world.joints.manager<distance_joint2D>()->size();
+}
+
+static void collect(const settings &st, const scene scn, const std::size_t count, world2D &world,
+                    std::vector<stage_result> &results)
+{
+    // Closes the last measured frame so that it is included in the statistics
+    frame_profiler::begin_frame();
+    frame_profiler::enabled(false);
+
+    stage_result base;
+    base.scene = name(scn);
+    base.mode = st.windowed ? "windowed" : "headless";
+    base.requested_count = count;
+    base.bodies = world.bodies.size();
+    base.colliders = world.colliders.size();
+    base.joints = joint_count(world);
+    base.frames = frame_profiler::frame_count();
+
+    const auto push = [&results, &base](const frame_profiler::scope_stats &stats) {
+        stage_result &result = results.emplace_back(base);
+        result.stage = stats.name;
+        result.average_ms = stats.average;
+        result.p50_ms = stats.p50;
+        result.p99_ms = stats.p99;
+    };
+
+    frame_profiler::scope_stats frame;
+    frame_profiler::compute_frame_stats(frame);
+    push(frame);
+
+    std::vector<frame_profiler::scope_stats> stages;
+    frame_profiler::compute_stats(stages);
+    for (const frame_profiler::scope_stats &stats : stages)
+        push(stats);
+}
+
+static void run(const settings &st, const scene scn, const std::size_t count, std::vector<stage_result> &results)
+{
+    std::cerr << "Running " << name(scn) << " with " << count << " bodies...\n";
+    if (st.windowed)
+    {
+        app::specs spc;
+        spc.worker_threads = st.worker_threads;
+        bench_app bapp{spc, st.warmup, st.frames};
+        build(scn, bapp.world, count);
+        bapp.run();
+        collect(st, scn, count, bapp.world, results);
+        return;
+    }
+
+    simulation::specs spc;
+    spc.worker_threads = st.worker_threads;
+    bench_simulation sim{spc};
+    build(scn, sim.world, count);
+
+    simulation::headless_specs hspc;
+    hspc.timestep = st.timestep;
+    hspc.frames = st.warmup;
+    sim.run_headless(hspc);
+
+    frame_profiler::enabled(true);
+    hspc.frames = st.frames;
+    sim.run_headless(hspc);
+    collect(st, scn, count, sim.world, results);
+}
+
+template <typename T> static bool parse_number(const std::string_view text, T &value)
+{
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+template <typename F> static bool split(const std::string_view list, F &&fn)
+{
+    std::size_t start = 0;
+    while (start <= list.size())
+    {
+        const std::size_t end = std::min(list.find(',', start), list.size());
+        if (!fn(list.substr(start, end - start)))
+            return false;
+        start = end + 1;
+    }
+    return true;
+}
+
+static void usage()
+{
+    std::cerr << "Usage: poly-physx-app-benchmarks [options]\n"
+                 "  --scenes a,b,...   circles, polygon_stacks, spring_chains, distance_meshes, asleep_pile\n"
+                 "  --counts n,m,...   body counts to sweep over (default 100,500,1000,5000)\n"
+                 "  --warmup n         frames run before measuring (default 120)\n"
+                 "  --frames n         frames measured, at most "
+              << frame_profiler::capacity
+              << " (default)\n"
+                 "  --threads n        worker threads\n"
+                 "  --windowed         run the full app with a window instead of headless\n"
+                 "  --output file      write results to a .json or .csv file instead of CSV to stdout\n";
+}
+
+static bool parse_args(const int argc, char **argv, settings &st)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--windowed")
+            st.windowed = true;
+        else if (arg == "--scenes" && has_value)
+        {
+            st.scenes.clear();
+            if (!split(argv[++i], [&st](const std::string_view text) { return parse(text, st.scenes.emplace_back()); }))
+                return false;
+        }
+        else if (arg == "--counts" && has_value)
+        {
+            st.counts.clear();
+            if (!split(argv[++i],
+                       [&st](const std::string_view text) { return parse_number(text, st.counts.emplace_back()); }))
+                return false;
+        }
+        else if (arg == "--warmup" && has_value)
+        {
+            if (!parse_number(argv[++i], st.warmup))
+                return false;
+        }
+        else if (arg == "--frames" && has_value)
+        {
+            if (!parse_number(argv[++i], st.frames) || st.frames == 0 || st.frames > frame_profiler::capacity)
+                return false;
+        }
+        else if (arg == "--threads" && has_value)
+        {
+            if (!parse_number(argv[++i], st.worker_threads))
+                return false;
+        }
+        else if (arg == "--output" && has_value)
+            st.output = argv[++i];
+        else
+            return false;
+    }
+    return true;
+}
+} // namespace ppx::bench
+
+int main(int argc, char **argv)
+{
+    using namespace ppx::bench;
+    settings st;
+    if (!parse_args(argc, argv, st))
+    {
+        usage();
+        return 1;
+    }
+
+    std::vector<stage_result> results;
+    for (const scene scn : st.scenes)
+        for (const std::size_t count : st.counts)
+            run(st, scn, count, results);
+
+    if (st.output.empty())
+    {
+        write_csv(std::cout, results);
+        return 0;
+    }
+
+    std::ofstream file{st.output};
+    if (!file)
+    {
+        std::cerr << "Could not open " << st.output << '\n';
+        return 1;
+    }
+    if (st.output.ends_with(".json"))
+        write_json(file, results);
+    else
+        write_csv(file, results);
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "report.hpp"
+
+namespace ppx::bench
+{
+void write_csv(std::ostream &stream, const std::vector<stage_result> &results)
+{
+    stream << "scene,mode,requested_count,bodies,colliders,joints,frames,stage,average_ms,p50_ms,p99_ms\n";
+    for (const stage_result &result : results)
+        stream << result.scene << ',' << result.mode << ',' << result.requested_count << ',' << result.bodies << ','
+               << result.colliders << ',' << result.joints << ',' << result.frames << ',' << result.stage << ','
+               << result.average_ms << ',' << result.p50_ms << ',' << result.p99_ms << '\n';
+}
+
+// Stage and scene names are identifiers without quotes or backslashes, so no escaping is needed
+void write_json(std::ostream &stream, const std::vector<stage_result> &results)
+{
+    stream << "[\n";
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const stage_result &result = results[i];
+        stream << "  {\"scene\": \"" << result.scene << "\", \"mode\": \"" << result.mode
+               << "\", \"requested_count\": " << result.requested_count << ", \"bodies\": " << result.bodies
+               << ", \"colliders\": " << result.colliders << ", \"joints\": " << result.joints
+               << ", \"frames\": " << result.frames << ", \"stage\": \"" << result.stage
+               << "\", \"average_ms\": " << result.average_ms << ", \"p50_ms\": " << result.p50_ms
+               << ", \"p99_ms\": " << result.p99_ms << '}' << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    stream << "]\n";
+}
+} // namespace ppx::bench
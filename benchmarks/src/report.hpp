@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstddef>
+
+namespace ppx::bench
+{
+struct stage_result
+{
+    std::string scene;
+    std::string mode;
+    std::size_t requested_count;
+    std::size_t bodies;
+    std::size_t colliders;
+    std::size_t joints;
+    std::size_t frames;
+
+    std::string stage;
+    float average_ms;
+    float p50_ms;
+    float p99_ms;
+};
+
+void write_csv(std::ostream &stream, const std::vector<stage_result> &results);
+void write_json(std::ostream &stream, const std::vector<stage_result> &results);
+} // namespace ppx::bench
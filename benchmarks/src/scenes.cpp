@@ -0,0 +1,204 @@
+#include "scenes.hpp"
+#include "ppx/joints/spring_joint.hpp"
+#include "ppx/joints/distance_joint.hpp"
+
+#include <cmath>
+
+namespace ppx::bench
+{
+static constexpr float spacing = 3.f;
+
+std::string_view name(const scene scn)
+{
+    switch (scn)
+    {
+    case scene::CIRCLES:
+        return "circles";
+    case scene::POLYGON_STACKS:
+        return "polygon_stacks";
+    case scene::SPRING_CHAINS:
+        return "spring_chains";
+    case scene::DISTANCE_MESHES:
+        return "distance_meshes";
+    case scene::ASLEEP_PILE:
+        return "asleep_pile";
+    }
+    return "unknown";
+}
+
+bool parse(const std::string_view name, scene &scn)
+{
+    for (const scene candidate : all_scenes)
+        if (bench::name(candidate) == name)
+        {
+            scn = candidate;
+            return true;
+        }
+    return false;
+}
+
+static std::size_t side_of(const std::size_t count)
+{
+    return std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<float>(count)))));
+}
+
+static body2D *add_ground(world2D &world, const float width, const float y)
+{
+    specs::collider2D collider;
+    collider.props.vertices = polygon::rect(width, 2.f);
+
+    specs::body2D body;
+    body.position = {0.f, y};
+    body.type = body2D::btype::STATIC;
+    body.props.colliders.push_back(collider);
+    return world.bodies.add(body);
+}
+
+static body2D *add_circle(world2D &world, const glm::vec2 &position, const float radius)
+{
+    specs::collider2D collider;
+    collider.props.shape = collider2D::stype::CIRCLE;
+    collider.props.radius = radius;
+
+    specs::body2D body;
+    body.position = position;
+    body.props.colliders.push_back(collider);
+    return world.bodies.add(body);
+}
+
+static body2D *add_box(world2D &world, const glm::vec2 &position, const float size)
+{
+    specs::collider2D collider;
+    collider.props.vertices = polygon::square(size);
+
+    specs::body2D body;
+    body.position = position;
+    body.props.colliders.push_back(collider);
+    return world.bodies.add(body);
+}
+
+static specs::joint2D joint_between(const body2D *body1, const body2D *body2)
+{
+    specs::joint2D joint;
+    joint.bindex1 = body1->meta.index;
+    joint.bindex2 = body2->meta.index;
+    joint.ganchor1 = body1->centroid();
+    joint.ganchor2 = body2->centroid();
+    return joint;
+}
+
+static void build_circles(world2D &world, const std::size_t count)
+{
+    const std::size_t side = side_of(count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        // A deterministic jitter keeps the layout from being a perfect lattice without depending on a random seed
+        const float jitter = 0.3f * std::sin(static_cast<float>(i) * 12.9898f);
+        const glm::vec2 position{spacing * static_cast<float>(i % side) + jitter,
+                                 spacing * static_cast<float>(i / side) - jitter};
+        body2D *body = add_circle(world, position, 1.f);
+        body->velocity = {jitter * 10.f, -jitter * 10.f};
+    }
+}
+
+static void build_polygon_stacks(world2D &world, const std::size_t count)
+{
+    constexpr std::size_t height = 20;
+    const std::size_t stacks = std::max<std::size_t>(1, count / height);
+    add_ground(world, spacing * static_cast<float>(stacks + 2), -2.f);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const glm::vec2 position{spacing * static_cast<float>(i % stacks), 2.05f * static_cast<float>(i / stacks)};
+        add_box(world, position, 2.f);
+    }
+}
+
+static void build_spring_chains(world2D &world, const std::size_t count)
+{
+    constexpr std::size_t length = 50;
+    const std::size_t chains = std::max<std::size_t>(1, count / length);
+    for (std::size_t c = 0; c < chains; c++)
+    {
+        body2D *previous = nullptr;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            body2D *body =
+                add_circle(world, {spacing * static_cast<float>(c), -spacing * static_cast<float>(i)}, 0.5f);
+            if (i == 0)
+                body->type(body2D::btype::STATIC);
+            if (previous)
+            {
+                specs::spring_joint2D spring;
+                spring.joint = joint_between(previous, body);
+                spring.props.frequency = 5.f;
+                spring.props.damping_ratio = 0.2f;
+                world.joints.add<spring_joint2D>(spring);
+            }
+            previous = body;
+        }
+    }
+}
+
+static void build_distance_meshes(world2D &world, const std::size_t count)
+{
+    const std::size_t side = side_of(count);
+    std::vector<body2D *> grid;
+    grid.reserve(side * side);
+    for (std::size_t i = 0; i < side * side; i++)
+    {
+        const glm::vec2 position{spacing * static_cast<float>(i % side), spacing * static_cast<float>(i / side)};
+        body2D *body = add_circle(world, position, 0.4f);
+        if (i / side == side - 1)
+            body->type(body2D::btype::STATIC);
+        grid.push_back(body);
+    }
+
+    const auto connect = [&world](const body2D *body1, const body2D *body2) {
+        specs::distance_joint2D distance;
+        distance.joint = joint_between(body1, body2);
+        world.joints.add<distance_joint2D>(distance);
+    };
+    for (std::size_t i = 0; i < grid.size(); i++)
+    {
+        if (i % side != side - 1)
+            connect(grid[i], grid[i + 1]);
+        if (i + side < grid.size())
+            connect(grid[i], grid[i + side]);
+    }
+}
+
+static void build_asleep_pile(world2D &world, const std::size_t count)
+{
+    // A resting grid of boxes on the ground: after the warmup nearly every body is asleep, which measures how cheap
+    // frames are when almost nothing moves
+    const std::size_t side = side_of(count);
+    add_ground(world, spacing * static_cast<float>(side + 2), -2.f);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const glm::vec2 position{2.01f * static_cast<float>(i % side), 2.01f * static_cast<float>(i / side)};
+        add_box(world, position, 2.f);
+    }
+}
+
+void build(const scene scn, world2D &world, const std::size_t count)
+{
+    switch (scn)
+    {
+    case scene::CIRCLES:
+        build_circles(world, count);
+        break;
+    case scene::POLYGON_STACKS:
+        build_polygon_stacks(world, count);
+        break;
+    case scene::SPRING_CHAINS:
+        build_spring_chains(world, count);
+        break;
+    case scene::DISTANCE_MESHES:
+        build_distance_meshes(world, count);
+        break;
+    case scene::ASLEEP_PILE:
+        build_asleep_pile(world, count);
+        break;
+    }
+}
+} // namespace ppx::bench
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ppx/world.hpp"
+
+#include <array>
+#include <string_view>
+#include <cstddef>
+
+namespace ppx::bench
+{
+enum class scene
+{
+    CIRCLES,
+    POLYGON_STACKS,
+    SPRING_CHAINS,
+    DISTANCE_MESHES,
+    ASLEEP_PILE
+};
+
+inline constexpr std::array<scene, 5> all_scenes{scene::CIRCLES, scene::POLYGON_STACKS, scene::SPRING_CHAINS,
+                                                  scene::DISTANCE_MESHES, scene::ASLEEP_PILE};
+
+std::string_view name(scene scn);
+bool parse(std::string_view name, scene &scn);
+
+// Fills an empty world with roughly count bodies laid out deterministically, so that runs are comparable
+void build(scene scn, world2D &world, std::size_t count);
+} // namespace ppx::bench
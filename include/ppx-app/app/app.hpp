@@ -1,52 +1,113 @@
 #pragma once
 
-#include "ppx/world.hpp"
-
-#include "ppx-app/drawables/joints/joint_repr.hpp"
-#include "ppx-app/drawables/shapes/collider_repr.hpp"
+#include "ppx-app/drawables/joints/joint_registry.hpp"
+#include "ppx-app/drawables/batches/collider_batch.hpp"
+#include "ppx-app/drawables/batches/capsule_batch.hpp"
+#include "ppx-app/drawables/batches/line_batch.hpp"
+#include "ppx-app/drawables/batches/debug_overlay.hpp"
+#include "ppx-app/app/simulation.hpp"
+#include "ppx-app/serialization/async_saver.hpp"
+#include "ppx-app/serialization/scene_loader.hpp"
 #include "ppx-app/app/menu_layer.hpp"
+#include "ppx-app/app/profiler_layer.hpp"
+#include "ppx-app/app/replay_layer.hpp"
+#include "ppx-app/app/telemetry_layer.hpp"
+#include "ppx-app/app/worlds_layer.hpp"
+#include "ppx-app/app/loader_layer.hpp"
 
 #include "lynx/app/app.hpp"
 #include "lynx/drawing/shape.hpp"
 
-#include "kit/memory/ptr/scope.hpp"
 #include "kit/serialization/yaml/serializer.hpp"
 
+#include <filesystem>
+
 namespace ppx
 {
-class app : public lynx::app2D
+// A simulation with a window and ImGui panels, or without either when headless. Not a lynx::app2D: lynx members not
+// forwarded below are reached through lynx_app()
+class app : public simulation
+#ifdef KIT_USE_YAML_CPP
+    , public kit::yaml::serializable, public kit::yaml::deserializable
+#endif
 {
   public:
-    inline static lynx::color collider_color{123u, 143u, 161u};
-    inline static lynx::color joint_color{207u, 185u, 151u};
-
-    struct specs
+    struct specs : simulation::specs
     {
-        ppx::specs::world2D world;
         lynx::window2D::specs window;
+        bool headless = false;
+        // Frame pacing of run() when headless. The framerate of the window specs is not used
+        headless_specs headless_run;
     };
 
     app(const specs &spc = {});
 
-    virtual ~app() = default;
+    virtual ~app();
 
-    world2D world;
-    bool sync_timestep = true;
-    bool paused = false;
-    float sync_speed = 0.01f;
-    float sleep_greyout = 0.6f;
+    // Calls on_start(), runs the window loop, or the headless loop when headless, and calls on_shutdown()
+    void run();
+    // Closes the window, or stops the headless loop
+    void shutdown();
+    bool headless() const;
 
-    std::uint32_t integrations_per_frame = 1;
+    // These return nullptr when headless, and push_layer() then does nothing
+    lynx::app2D *lynx_app();
+    const lynx::app2D *lynx_app() const;
+    lynx::window2D *window();
+    const lynx::window2D *window() const;
 
-    kit::perf::time physics_time() const;
+    template <typename T, typename... LayerArgs> T *push_layer(LayerArgs &&...args)
+    {
+        if (!m_host)
+            return nullptr;
+        return m_host->push_layer<T>(std::forward<LayerArgs>(args)...);
+    }
+    bool pop_layer(const lynx::layer2D *layer);
 
+    // Headless apps only remember the cap, so that it survives saving and loading scenes
+    std::uint32_t framerate_cap() const;
+    void limit_framerate(std::uint32_t framerate);
+
+    float joint_cull_margin = 1.f;
+
+    collider_batch2D::lod_settings shape_lod;
+    // Springs shorter than this on screen, in pixels, are drawn as straight lines
+    float spring_detail_length = 12.f;
+
+    // Toggled from the View menu. Drawn on top of everything else when any of its views is enabled
+    debug_overlay2D overlay;
+
+    // Without a camera, headless apps report the origin and the last area and pixel size passed to view()
     glm::vec2 world_mouse_position() const;
-    const std::unordered_map<collider2D *, collider_repr2D> &shapes() const;
-    void color(collider2D *collider, const lynx::color &color);
+    // Topmost collider under the mouse cursor, or nullptr. See simulation::collider_at()
+    collider2D *collider_under_mouse();
+    bounds2D visible_area() const;
+    float pixel_size() const;
+
+    virtual void report_memory(memory_report &report) const override;
 
+    virtual void on_start();
     virtual void on_update(float ts) override;
-    virtual void on_render(float ts) override;
-    virtual bool on_event(const lynx::event2D &event) override;
+    virtual void on_render(float ts);
+    virtual void on_shutdown();
+    virtual bool on_event(const lynx::event2D &event);
+
+    // Binary counterparts of encode() and decode(), much faster for large scenes. See binary_snapshot
+    bool save_snapshot(const std::filesystem::path &path) const;
+    bool load_snapshot(const std::filesystem::path &path);
+
+    // Captures the current frame and writes it in the background. The callbacks run from a later on_update()
+    bool save_snapshot_async(const std::filesystem::path &path, async_saver::callback on_complete = {},
+                             async_saver::callback on_error = {});
+    async_saver &saver();
+
+    // Loads a binary snapshot or YAML scene progressively. See scene_loader
+    bool load_snapshot_async(const std::filesystem::path &path);
+    scene_loader &loader();
+
+    // Camera, framerate and lynx app state. Headless apps hand back the last applied view
+    binary_snapshot::view_state snapshot_view() const;
+    void apply_view(const binary_snapshot::view_state &view);
 
 #ifdef KIT_USE_YAML_CPP
     virtual YAML::Node encode() const override;
@@ -54,24 +115,52 @@ class app : public lynx::app2D
 #endif
 
   private:
-    lynx::window2D *m_window;
-    lynx::orthographic2D *m_camera;
+    // Owns the window and forwards its callbacks to the app
+    class window_host final : public lynx::app2D
+    {
+      public:
+        window_host(app &owner, const lynx::window2D::specs &spc);
 
-    std::unordered_map<collider2D *, collider_repr2D> m_shapes;
-    std::unordered_map<joint2D *, kit::scope<joint_repr2D>> m_joints;
+      private:
+        app &m_app;
 
-    kit::perf::time m_physics_time;
+        void on_start() override;
+        void on_update(float ts) override;
+        void on_render(float ts) override;
+        void on_shutdown() override;
+        bool on_event(const lynx::event2D &event) override;
+    };
+
+    kit::scope<window_host> m_host;
+    lynx::window2D *m_window = nullptr;
+    lynx::orthographic2D *m_camera = nullptr;
+    headless_specs m_headless_run;
+    binary_snapshot::view_state m_detached_view;
+
+    builtin_joint_registry2D m_joints;
+
+    collider_batch2D m_collider_batch;
+    capsule_batch2D m_capsule_batch;
+    line_batch2D m_line_batch;
+
+    async_saver m_saver;
+    scene_loader m_loader;
 
-    void update_shapes();
     void update_joints();
 
-    void draw_shapes() const;
-    void draw_joints() const;
+    void draw_shapes();
+    void draw_overlay();
+    void draw_joints();
+
+    template <typename Repr> void update_joint_reprs(repr_array<Repr> &reprs);
+    template <typename Repr> static void report_joint_memory(memory_report &report, const repr_array<Repr> &reprs);
 
     void zoom(float offset);
     void move_camera(float ts);
 
-    void add_world_callbacks();
+    void add_joint_callbacks();
+    template <typename Repr> void add_joint_callbacks(repr_array<Repr> &reprs);
+    void reserve_joint_reprs(std::type_index joint, std::size_t count) override;
 };
 
 } // namespace ppx
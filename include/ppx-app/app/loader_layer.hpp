@@ -0,0 +1,26 @@
+#pragma once
+
+#include "lynx/app/layer.hpp"
+
+#include <array>
+
+namespace ppx
+{
+class scene_loader;
+
+// Starts, shows and cancels progressive scene loads
+class loader_layer final : public lynx::layer2D
+{
+  public:
+    loader_layer(scene_loader &loader);
+
+  private:
+    scene_loader &m_loader;
+    std::array<char, 256> m_path{"scene.ppxs"};
+    bool m_visible = false;
+
+    void on_render(float ts) override;
+
+    void render_progress();
+};
+} // namespace ppx
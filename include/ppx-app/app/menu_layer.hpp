@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ppx-app/drawables/batches/debug_overlay.hpp"
+
 #include "lynx/app/layer.hpp"
 #include "lynx/app/window.hpp"
 
@@ -8,12 +10,15 @@ namespace ppx
 class menu_layer final : public lynx::layer2D
 {
   public:
-    menu_layer();
+    menu_layer(debug_overlay2D &overlay);
 
   private:
     void on_attach() override;
     void on_render(float ts) override;
 
     lynx::window2D *m_window;
+    debug_overlay2D &m_overlay;
+
+    void render_overlay_menu();
 };
 } // namespace ppx
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "ppx-app/profiling/frame_profiler.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+#include "lynx/app/layer.hpp"
+
+#include <vector>
+
+namespace ppx
+{
+class simulation;
+
+// Per-stage frame timings, substepping and memory usage. The profiler only records while the panel is open
+class profiler_layer final : public lynx::layer2D
+{
+  public:
+    profiler_layer(simulation &sim);
+
+  private:
+    simulation &m_sim;
+    std::vector<frame_profiler::scope_stats> m_stats;
+    std::vector<float> m_timeline;
+    memory_report m_memory;
+
+    void on_render(float ts) override;
+
+    void render_table();
+    void render_timeline();
+    void render_flame_view() const;
+    void render_stepping();
+    void render_memory();
+};
+} // namespace ppx
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "lynx/app/layer.hpp"
+
+#include <array>
+
+namespace ppx
+{
+class simulation;
+
+// Replay recording and playback controls, with a timeline slider to scrub through recordings
+class replay_layer final : public lynx::layer2D
+{
+  public:
+    replay_layer(simulation &sim);
+
+  private:
+    simulation &m_sim;
+    std::array<char, 256> m_path{"replay.ppxr"};
+    bool m_visible = false;
+
+    void on_render(float ts) override;
+
+    void render_recorder();
+    void render_player();
+};
+} // namespace ppx
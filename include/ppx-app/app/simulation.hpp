@@ -0,0 +1,268 @@
+#pragma once
+
+#include "ppx/world.hpp"
+
+#include "ppx-app/app/substep_controller.hpp"
+#include "ppx-app/drawables/shapes/collider_repr.hpp"
+#include "ppx-app/drawables/repr_array.hpp"
+#include "ppx-app/profiling/frame_profiler.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+#include "ppx-app/profiling/world_telemetry.hpp"
+#include "ppx-app/replay/replay_player.hpp"
+#include "ppx-app/replay/replay_recorder.hpp"
+#include "ppx-app/threading/job_pool.hpp"
+#include "ppx-app/threading/physics_thread.hpp"
+#include "ppx-app/threading/world_runner.hpp"
+#include "ppx-app/utility/spatial_grid.hpp"
+
+#include "kit/memory/ptr/scope.hpp"
+
+#include <atomic>
+#include <typeindex>
+
+namespace ppx
+{
+// The window independent part of an app. It can run on its own, without a display, through run_headless()
+class simulation
+{
+  public:
+    inline static lynx::color collider_color{123u, 143u, 161u};
+    inline static lynx::color joint_color{207u, 185u, 151u};
+
+    struct specs
+    {
+        ppx::specs::world2D world;
+        std::size_t worker_threads = job_pool::default_thread_count();
+
+        bool threaded_physics = false;
+        float physics_rate = 60.f;
+    };
+
+    struct headless_specs
+    {
+        // Timestep passed to on_update() every frame
+        float timestep = 1.f / 60.f;
+        // Frames per second. A rate of 0 runs the loop as fast as possible
+        float rate = 0.f;
+        // Amount of frames to run. 0 runs until stop_headless() is called
+        std::uint64_t frames = 0;
+    };
+
+    struct culling_stats
+    {
+        std::size_t visible_colliders = 0;
+        std::size_t culled_colliders = 0;
+        std::size_t visible_joints = 0;
+        std::size_t culled_joints = 0;
+    };
+
+    simulation();
+    simulation(const specs &spc);
+    virtual ~simulation() = default;
+
+    world2D world;
+    bool sync_timestep = true;
+    bool paused = false;
+    float sync_speed = 0.01f;
+    float sleep_greyout = 0.6f;
+
+    std::uint32_t integrations_per_frame = 1;
+    // Replaces integrations_per_frame and sync_timestep when enabled, unless physics run on their own thread
+    substep_controller substeps;
+    std::size_t update_grain = 256;
+
+    bool frustum_culling = true;
+    // Headless runs that only care about the world can skip refreshing the collider representations
+    bool update_reprs = true;
+
+    // An open replay drives the representations instead of the world, which must have the recording's topology
+    replay_recorder recorder;
+    replay_player player;
+
+    // Sampled by whichever thread steps the world, once per frame when substepping
+    world_telemetry telemetry;
+
+    // Independent worlds for parameter sweeps, stepped on the job pool after the main world
+    world_runner sweep;
+
+    // Checked every memory_check_interval updates. Exceeding a limit logs a warning once, until usage drops below it
+    memory_report::budget memory_budget;
+    std::uint32_t memory_check_interval = 60;
+
+    // Steps the world and refreshes the visible collider representations
+    virtual void on_update(float ts);
+
+    void run_headless();
+    void run_headless(const headless_specs &spc);
+    void stop_headless();
+    bool running_headless() const;
+
+    kit::perf::time physics_time() const;
+
+    job_pool &jobs();
+
+    // Must be held to access the world while the physics thread runs
+    bool threaded_physics() const;
+    std::unique_lock<std::mutex> lock_world() const;
+
+    const culling_stats &culling() const;
+
+    // Memory held on top of the engine, per subsystem. Apps add their own subsystems to the report
+    virtual void report_memory(memory_report &report) const;
+    bool over_memory_budget() const;
+
+    const repr_array<circle_repr2D> &circles() const;
+    const repr_array<polygon_repr2D> &polygons() const;
+    const polygon_mesh_cache &meshes() const;
+
+    const collider_repr2D &shape(const collider2D *collider) const;
+    const lynx::color &color(const collider2D *collider) const;
+    void color(const collider2D *collider, const lynx::color &color);
+
+    // Keeps a batch open for its lifetime, so that it is closed even if an addition throws
+    class batch_guard
+    {
+      public:
+        explicit batch_guard(simulation &sim, std::size_t expected_colliders = 0);
+        ~batch_guard();
+
+        batch_guard(const batch_guard &) = delete;
+        batch_guard &operator=(const batch_guard &) = delete;
+
+      private:
+        simulation &m_sim;
+    };
+
+    // Bulk additions. Collider representations are built when the last open batch closes, or before a removal
+    batch_guard batch(std::size_t expected_colliders = 0);
+    bool batching() const;
+
+    // Adds every body within a single batch and a single world lock
+    void add_bodies(const std::vector<ppx::specs::body2D> &bodies);
+    // Adds every joint within a single world lock, with representation storage reserved once for all of them
+    template <typename Joint> void add_joints(const std::vector<typename Joint::specs> &joints)
+    {
+        const auto lock = lock_world();
+        reserve_joint_reprs(typeid(Joint), joints.size());
+        for (const typename Joint::specs &spc : joints)
+            world.joints.add<Joint>(spc);
+    }
+
+    // Sleeping colliders are not refreshed every frame. Call this after moving one without waking it up
+    void mark_dirty(const collider2D *collider);
+
+    // World space picking through the culling grid. Point queries test exact shapes, area queries bounding boxes
+    collider2D *collider_at(const glm::vec2 &point);
+    void colliders_at(const glm::vec2 &point, std::vector<collider2D *> &colliders);
+    void colliders_in(const bounds2D &area, std::vector<collider2D *> &colliders, bool fully_inside = false);
+
+  protected:
+    // Declared before the polygons so that it outlives the handles they hold
+    polygon_mesh_cache m_meshes;
+    repr_array<circle_repr2D> m_circles;
+    repr_array<polygon_repr2D> m_polygons;
+
+    job_pool m_jobs;
+
+    // Called before count joints of the given type are added. Simulations drawing joints reserve their storage here
+    virtual void reserve_joint_reprs(std::type_index joint, std::size_t count);
+
+    kit::scope<physics_thread> m_physics_thread;
+    world_snapshot m_previous_snapshot;
+    world_snapshot m_current_snapshot;
+    float m_interpolation = 1.f;
+
+    bounds2D m_view;
+    float m_pixel_size = 0.f;
+    culling_stats m_culling;
+    std::uint64_t m_frame = 0;
+
+    collider_repr2D &shape(const collider2D *collider);
+
+    // Area the colliders are culled against, and the world size of a pixel. Without a view nothing is culled
+    void view(const bounds2D &area, float pixel_size);
+
+    void single_step();
+
+    // Whether the representations are refreshed from m_current_snapshot rather than from the world
+    bool snapshot_driven() const;
+
+    // Grid over the collider bounding boxes of the current frame, indexed by collider index
+    const spatial_grid2D &shape_grid();
+
+    template <typename F> void for_each_visible_shape(F &&fn, const bool parallel)
+    {
+        if (!culling_enabled())
+        {
+            if (parallel)
+            {
+                m_jobs.for_each(m_circles, fn, update_grain);
+                m_jobs.for_each(m_polygons, fn, update_grain);
+            }
+            else
+            {
+                for (circle_repr2D &crepr : m_circles)
+                    fn(crepr);
+                for (polygon_repr2D &prepr : m_polygons)
+                    fn(prepr);
+            }
+            return;
+        }
+
+        const auto visit = [this, &fn](const std::size_t start, const std::size_t end) {
+            for (std::size_t i = start; i < end; i++)
+            {
+                const std::size_t index = m_visible_colliders[i];
+                if (circle_repr2D *crepr = m_circles.find(index))
+                    fn(*crepr);
+                else if (polygon_repr2D *prepr = m_polygons.find(index))
+                    fn(*prepr);
+            }
+        };
+        if (parallel)
+            m_jobs.parallel_for(0, m_visible_colliders.size(), visit, update_grain);
+        else
+            visit(0, m_visible_colliders.size());
+    }
+
+  private:
+    kit::perf::time m_physics_time;
+    bool m_substeps_paused = false;
+
+    spatial_grid2D m_shape_grid;
+    bool m_shape_grid_valid = false;
+    std::vector<std::size_t> m_visible_colliders;
+    bool m_has_view = false;
+
+    // Only changed by batch_guard
+    std::uint32_t m_batch_depth = 0;
+    std::vector<collider2D *> m_batched_colliders;
+
+    memory_report m_memory_report;
+    bool m_over_memory_budget = false;
+
+    std::atomic<bool> m_headless_running{false};
+    world_snapshot m_replay_snapshot;
+
+    bool culling_enabled() const;
+
+    void step_physics(float ts);
+    void step_world(bool sample_telemetry = true);
+    bool sync_physics_thread();
+
+    void play_replay();
+    void record_replay(bool new_snapshot);
+
+    void build_shape_grid();
+    collider2D *picking_state(std::size_t index, collider_state &state) const;
+    collider2D *contains(std::size_t index, const glm::vec2 &point) const;
+
+    void update_visibility();
+    void update_shapes();
+    void check_memory_budget();
+
+    void add_collider_callbacks();
+    void add_collider_repr(collider2D *collider);
+    void flush_batched_colliders();
+};
+} // namespace ppx
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ppx
+{
+// Picks each frame's substeps and timestep to stay within a physics time budget, growing the timestep up to
+// max_timestep and dropping backlog beyond max_catch_up seconds
+class substep_controller
+{
+  public:
+    struct plan
+    {
+        std::uint32_t substeps = 0;
+        float timestep = 0.f;
+    };
+
+    struct stats
+    {
+        // Simulated time over real time, smoothed over the last frames. Below 1 the simulation falls behind
+        float real_time_factor = 1.f;
+        std::uint32_t substeps = 0;
+        float timestep = 0.f;
+        // Smoothed cost of a single substep, in seconds
+        float substep_cost = 0.f;
+        float budget_usage = 0.f;
+        // Real time waiting to be simulated, and total time given up because of the catch up cap
+        float backlog = 0.f;
+        float dropped_time = 0.f;
+    };
+
+    bool enabled = false;
+
+    // Seconds of physics per frame
+    float budget = 0.008f;
+    float timestep = 1.f / 120.f;
+    float max_timestep = 1.f / 30.f;
+    float max_catch_up = 0.1f;
+    std::uint32_t max_substeps = 16;
+    float smoothing = 0.1f;
+
+    plan next(float frame_time);
+    // Feeds back the time the planned substeps took, in seconds
+    void report(const plan &pln, float physics_time);
+    void reset();
+    // Drops the real time waiting to be simulated, keeping the measured substep cost
+    void clear_backlog();
+
+    const stats &statistics() const;
+
+  private:
+    stats m_stats;
+    float m_accumulator = 0.f;
+    float m_frame_time = 0.f;
+};
+} // namespace ppx
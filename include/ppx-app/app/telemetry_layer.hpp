@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ppx-app/profiling/world_telemetry.hpp"
+#include "lynx/app/layer.hpp"
+
+#include <array>
+#include <vector>
+
+namespace ppx
+{
+class simulation;
+
+// Plots the simulation's world telemetry and exports it to CSV
+class telemetry_layer final : public lynx::layer2D
+{
+  public:
+    telemetry_layer(simulation &sim);
+
+  private:
+    simulation &m_sim;
+    std::array<char, 256> m_path{"telemetry.csv"};
+    bool m_visible = false;
+
+    std::vector<telemetry_sample> m_samples;
+    std::vector<double> m_steps;
+    std::vector<double> m_values;
+
+    void on_render(float ts) override;
+
+    void render_controls();
+    void render_plots();
+    template <typename F> void plot(const char *label, F &&value);
+};
+} // namespace ppx
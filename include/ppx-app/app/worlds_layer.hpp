@@ -0,0 +1,34 @@
+#pragma once
+
+#include "lynx/app/layer.hpp"
+
+#include <array>
+
+namespace ppx
+{
+class simulation;
+
+// Sweep world controls, with ImGui drawn thumbnails of each world's collider bounding boxes
+class worlds_layer final : public lynx::layer2D
+{
+  public:
+    worlds_layer(simulation &sim);
+
+    float thumbnail_size = 160.f;
+    // Thumbnails of larger worlds only draw an evenly spread subset of their colliders
+    std::size_t thumbnail_budget = 2000;
+
+  private:
+    simulation &m_sim;
+    std::array<char, 256> m_path{"sweep.csv"};
+    std::array<char, 256> m_snapshot_path{"scene.ppx"};
+    bool m_visible = false;
+    std::size_t m_selected = 0;
+
+    void on_render(float ts) override;
+
+    void render_controls();
+    void render_thumbnails();
+    void render_selected();
+};
+} // namespace ppx
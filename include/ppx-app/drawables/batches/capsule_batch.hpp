@@ -0,0 +1,48 @@
+#pragma once
+
+#include "lynx/drawing/drawable.hpp"
+#include "lynx/drawing/color.hpp"
+#include "lynx/geometry/vertex.hpp"
+#include "lynx/app/window.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_INTRINSICS
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace ppx
+{
+// Accumulates capsules into a single triangle list, each expanded from a precomputed outline
+class capsule_batch2D final : public lynx::drawable2D
+{
+  public:
+    capsule_batch2D(std::uint32_t cap_segments = 8);
+
+    void clear();
+    void reserve(std::size_t capsules);
+
+    void push(const glm::vec2 &p1, const glm::vec2 &p2, float radius, const lynx::color &color);
+    void draw(lynx::window2D &window) const override;
+
+    std::size_t size() const;
+    bool empty() const;
+
+    std::size_t memory() const;
+    std::size_t uploaded_bytes() const;
+
+  private:
+    struct outline_vertex
+    {
+        bool second_endpoint;
+        glm::vec2 offset;
+    };
+
+    std::vector<outline_vertex> m_outline;
+    std::vector<lynx::vertex2D> m_vertices;
+    std::vector<std::uint32_t> m_indices;
+    std::size_t m_size = 0;
+};
+} // namespace ppx
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "lynx/drawing/drawable.hpp"
+#include "lynx/drawing/color.hpp"
+#include "lynx/geometry/vertex.hpp"
+#include "lynx/app/window.hpp"
+#include "ppx-app/drawables/shapes/polygon_mesh.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_INTRINSICS
+#include <glm/glm.hpp>
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace ppx
+{
+// Gathers every collider of a frame into a few shared buffers, with circles expanded at a detail level per screen size
+class collider_batch2D final : public lynx::drawable2D
+{
+  public:
+    static inline constexpr std::size_t circle_levels = 4;
+
+    struct lod_settings
+    {
+        bool enabled = true;
+        // On-screen radius, in pixels, above which circles get full detail. Each level below halves the segments
+        float full_detail_radius = 40.f;
+        std::uint32_t min_circle_segments = 6;
+        float subpixel_radius = 0.5f;
+        bool skip_subpixel = false;
+    };
+
+    collider_batch2D(std::uint32_t circle_segments = 30);
+
+    lynx::color marker_color = lynx::color::white;
+    bool draw_markers = true;
+    lod_settings lod;
+
+    void clear();
+    void reserve(std::size_t circles, std::size_t polygon_vertices);
+
+    // World units covered by a single pixel, used to pick detail levels
+    void pixel_size(float pixel_size);
+
+    void push_circle(const glm::mat3 &transform, float radius, const lynx::color &color);
+
+    // Cached meshes know their radius, so polygons drawn as points skip transforming their outline
+    void push_polygon(const glm::mat3 &transform, const polygon_mesh &mesh, const lynx::color &color);
+
+    template <typename It>
+    void push_polygon(const glm::mat3 &transform, It first, const It last, const lynx::color &color)
+    {
+        const auto base = static_cast<std::uint32_t>(m_polygon_vertices.size());
+        for (; first != last; ++first)
+            m_polygon_vertices.push_back({glm::vec2(transform * glm::vec3(*first, 1.f)), color});
+        close_polygon(base);
+    }
+
+    void draw(lynx::window2D &window) const override;
+
+    std::uint32_t circle_segments() const;
+    std::size_t circle_count() const;
+    std::size_t polygon_count() const;
+    std::size_t point_count() const;
+
+    // Bytes reserved by the batch's buffers, and bytes of vertices and indices submitted by the last draw
+    std::size_t memory() const;
+    std::size_t uploaded_bytes() const;
+
+  private:
+    struct circle_instance
+    {
+        glm::vec2 position;
+        glm::vec2 axis;
+        lynx::color color;
+    };
+
+    struct circle_level
+    {
+        std::uint32_t segments;
+        std::vector<glm::vec2> unit_circle;
+        std::vector<circle_instance> instances;
+
+        mutable std::vector<lynx::vertex2D> vertices;
+        mutable std::vector<std::uint32_t> indices;
+    };
+
+    std::uint32_t m_circle_segments;
+    std::array<circle_level, circle_levels> m_levels;
+    float m_pixel_size = 0.f;
+
+    std::vector<lynx::vertex2D> m_polygon_vertices;
+    std::vector<std::uint32_t> m_polygon_indices;
+    std::size_t m_polygon_count = 0;
+
+    std::vector<lynx::vertex2D> m_points;
+
+    mutable std::vector<lynx::vertex2D> m_marker_vertices;
+
+    bool push_point(const glm::vec2 &position, float radius, const lynx::color &color);
+    void close_polygon(std::uint32_t base);
+    void triangulate(std::uint32_t base);
+    void expand_circles(const circle_level &level) const;
+};
+} // namespace ppx
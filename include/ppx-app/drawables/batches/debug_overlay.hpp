@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ppx-app/drawables/batches/line_batch.hpp"
+#include "ppx-app/utility/spatial_grid.hpp"
+#include "ppx/world.hpp"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+namespace ppx
+{
+// Debug views of the collision pipeline and of the app's culling grid, streamed into a single line batch
+class debug_overlay2D final : public lynx::drawable2D
+{
+  public:
+    struct stats
+    {
+        std::size_t cells = 0;
+        std::uint32_t max_occupancy = 0;
+        std::size_t bounds = 0;
+        std::size_t overlaps = 0;
+        std::size_t groups = 0;
+        bool truncated = false;
+
+        std::size_t broad_phase_cells = 0;
+        std::size_t contacts = 0;
+        std::size_t islands = 0;
+    };
+
+    bool show_broad_phase = false;
+    bool show_contacts = false;
+    bool show_islands = false;
+
+    bool show_grid = false;
+    bool show_bounds = false;
+    bool show_overlaps = false;
+    bool show_groups = false;
+
+    // Overlap gathering stops after this many pairs so that very dense views stay interactive
+    std::size_t max_overlaps = 50000;
+    // Half size, in pixels, of the crosses points are drawn with
+    float point_size = 3.f;
+
+    lynx::color grid_color{60u, 90u, 120u};
+    lynx::color crowded_cell_color{230u, 80u, 60u};
+    lynx::color bounds_color{120u, 200u, 120u};
+    lynx::color overlap_color{240u, 220u, 80u};
+    lynx::color broad_phase_color{150u, 110u, 200u};
+    lynx::color contact_color{250u, 60u, 60u};
+
+    bool enabled() const;
+
+    // The world is only read, and must not be stepped meanwhile
+    void build(const world2D &world, const spatial_grid2D &grid, const bounds2D &view, float pixel_size);
+    void draw(lynx::window2D &window) const override;
+
+    const stats &statistics() const;
+
+    std::size_t memory() const;
+    std::size_t uploaded_bytes() const;
+
+  private:
+    line_batch2D m_lines;
+    stats m_stats;
+
+    std::vector<std::pair<std::size_t, bounds2D>> m_visible;
+    std::vector<std::size_t> m_parents;
+    std::vector<std::size_t> m_sizes;
+
+    std::vector<std::uint32_t> m_islands;
+    std::vector<bounds2D> m_island_bounds;
+    std::vector<std::uint8_t> m_island_state;
+
+    void build_broad_phase(const world2D &world, const bounds2D &view);
+    void build_contacts(const world2D &world, const bounds2D &view, float pixel_size);
+    void build_islands(const world2D &world, const spatial_grid2D &grid, const bounds2D &view);
+    void build_grid(const spatial_grid2D &grid, const bounds2D &view);
+    void build_overlaps(const spatial_grid2D &grid, float pixel_size);
+
+    void push_box(const bounds2D &bounds, const lynx::color &color);
+    void push_point(const glm::vec2 &point, float size, const lynx::color &color);
+
+    std::size_t root(std::size_t id);
+    void unite(std::size_t id1, std::size_t id2);
+};
+} // namespace ppx
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "lynx/drawing/drawable.hpp"
+#include "lynx/drawing/color.hpp"
+#include "lynx/geometry/vertex.hpp"
+#include "lynx/app/window.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_INTRINSICS
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace ppx
+{
+// Streams any number of thin line segments into a single line list, drawn in one call
+class line_batch2D final : public lynx::drawable2D
+{
+  public:
+    void clear();
+    void reserve(std::size_t lines);
+
+    void push(const glm::vec2 &p1, const glm::vec2 &p2, const lynx::color &color);
+    void draw(lynx::window2D &window) const override;
+
+    std::size_t size() const;
+    bool empty() const;
+
+    std::size_t memory() const;
+    std::size_t uploaded_bytes() const;
+
+  private:
+    std::vector<lynx::vertex2D> m_vertices;
+};
+} // namespace ppx
@@ -2,6 +2,7 @@
 
 #include "ppx-app/drawables/lines/thick_line.hpp"
 #include "ppx-app/drawables/joints/joint_repr.hpp"
+#include "ppx-app/threading/world_snapshot.hpp"
 #include "ppx/joints/distance_joint.hpp"
 
 namespace ppx
@@ -9,8 +10,18 @@ namespace ppx
 class distance_repr2D final : public joint_repr2D
 {
   public:
+    using joint_type = distance_joint2D;
+    static inline constexpr auto snapshot = &world_snapshot::distances;
+
     distance_repr2D(const distance_joint2D *dj, float sleep_greyout);
 
+    void update(float sleep_greyout);
+    void update(const joint_state &state, float sleep_greyout);
+    joint_state state() const;
+    void draw(joint_batches2D &batches) const;
+
+    const distance_joint2D *joint() const;
+
     static inline lynx::color stretch = lynx::color::blue;
     static inline lynx::color relax = lynx::color::white * 0.8f;
     static inline lynx::color compress = lynx::color::red;
@@ -18,10 +29,5 @@ class distance_repr2D final : public joint_repr2D
   private:
     const distance_joint2D *m_dj;
     thick_line2D m_line;
-    lynx::color m_color1;
-    lynx::color m_color2;
-
-    void update(float sleep_greyout) override;
-    void draw(lynx::window2D &window) const override;
 };
-} // namespace ppx
\ No newline at end of file
+} // namespace ppx
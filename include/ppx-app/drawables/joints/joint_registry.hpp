@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ppx-app/drawables/repr_array.hpp"
+#include "ppx-app/drawables/joints/spring_repr.hpp"
+#include "ppx-app/drawables/joints/distance_repr.hpp"
+#include "ppx-app/drawables/joints/prismatic_repr.hpp"
+#include "ppx-app/drawables/joints/link_repr.hpp"
+
+#include <tuple>
+
+namespace ppx
+{
+// One repr_array per joint representation type, visited through loops expanded at compile time
+template <typename... Reprs> class joint_registry2D
+{
+  public:
+    template <typename Repr> repr_array<Repr> &reprs()
+    {
+        return std::get<repr_array<Repr>>(m_reprs);
+    }
+    template <typename Repr> const repr_array<Repr> &reprs() const
+    {
+        return std::get<repr_array<Repr>>(m_reprs);
+    }
+
+    // fn(reprs) is called with the repr_array of every type, in declaration order
+    template <typename F> void for_each_type(F &&fn)
+    {
+        std::apply([&fn](auto &...reprs) { (fn(reprs), ...); }, m_reprs);
+    }
+    template <typename F> void for_each_type(F &&fn) const
+    {
+        std::apply([&fn](const auto &...reprs) { (fn(reprs), ...); }, m_reprs);
+    }
+
+    std::size_t size() const
+    {
+        return std::apply([](const auto &...reprs) { return (reprs.size() + ...); }, m_reprs);
+    }
+
+  private:
+    std::tuple<repr_array<Reprs>...> m_reprs;
+};
+
+using builtin_joint_registry2D = joint_registry2D<spring_repr2D, distance_repr2D, prismatic_repr2D, revolute_repr2D,
+                                                  weld_repr2D, rotor_repr2D, motor_repr2D, ball_repr2D>;
+} // namespace ppx
@@ -1,14 +1,30 @@
 #pragma once
 
-#include "lynx/drawing/drawable.hpp"
+#include "ppx-app/drawables/batches/line_batch.hpp"
+#include "ppx-app/drawables/batches/capsule_batch.hpp"
+#include "ppx-app/drawables/update_tracker.hpp"
+#include "ppx-app/utility/bounds.hpp"
+#include "lynx/app/window.hpp"
 
 namespace ppx
 {
-class joint_repr2D : public lynx::drawable2D
+// Shared batches joint representations draw to, submitted once every joint type has been visited
+struct joint_batches2D
 {
-  public:
-    virtual ~joint_repr2D() = default;
+    lynx::window2D &window;
+    line_batch2D &lines;
+    capsule_batch2D &capsules;
+};
 
-    virtual void update(float sleep_greyout) = 0;
+// Common state of every joint representation. Representations are used through their concrete type, which provides
+// joint_type, snapshot, update(), state(), joint() and draw()
+class joint_repr2D
+{
+  public:
+    bool visible = true;
+    // Cleared by the app when the joint is too small on screen to be worth drawing in full
+    bool detailed = true;
+    bounds2D bounds;
+    update_tracker tracker;
 };
-} // namespace ppx
\ No newline at end of file
+} // namespace ppx
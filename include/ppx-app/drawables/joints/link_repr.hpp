@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ppx-app/drawables/joints/joint_repr.hpp"
+#include "ppx-app/threading/world_snapshot.hpp"
+#include "ppx/joints/revolute_joint.hpp"
+#include "ppx/joints/weld_joint.hpp"
+#include "ppx/joints/rotor_joint.hpp"
+#include "ppx/joints/motor_joint.hpp"
+#include "ppx/joints/ball_joint.hpp"
+
+namespace ppx
+{
+// Batched segment between the anchors of joints that have no dedicated look
+template <typename Joint, std::vector<joint_state> world_snapshot::*Snapshot>
+class link_repr2D final : public joint_repr2D
+{
+  public:
+    using joint_type = Joint;
+    static inline constexpr auto snapshot = Snapshot;
+
+    link_repr2D(const Joint *joint, const lynx::color &color, const float sleep_greyout)
+        : m_joint(joint), m_color(color), m_current_color(color)
+    {
+        update(sleep_greyout);
+    }
+
+    void update(const float sleep_greyout)
+    {
+        update(state(), sleep_greyout);
+    }
+    void update(const joint_state &state, const float sleep_greyout)
+    {
+        m_anchor1 = state.anchor1;
+        m_anchor2 = state.anchor2;
+        m_current_color = state.asleep ? sleep_greyout * m_color : m_color;
+    }
+
+    joint_state state() const
+    {
+        return {m_joint, m_joint->ganchor1(), m_joint->ganchor2(), 0.f, m_joint->asleep()};
+    }
+    void draw(joint_batches2D &batches) const
+    {
+        batches.lines.push(m_anchor1, m_anchor2, m_current_color);
+    }
+
+    const Joint *joint() const
+    {
+        return m_joint;
+    }
+
+  private:
+    const Joint *m_joint;
+    glm::vec2 m_anchor1{0.f};
+    glm::vec2 m_anchor2{0.f};
+    lynx::color m_color;
+    lynx::color m_current_color;
+};
+
+using revolute_repr2D = link_repr2D<revolute_joint2D, &world_snapshot::revolutes>;
+using weld_repr2D = link_repr2D<weld_joint2D, &world_snapshot::welds>;
+using rotor_repr2D = link_repr2D<rotor_joint2D, &world_snapshot::rotors>;
+using motor_repr2D = link_repr2D<motor_joint2D, &world_snapshot::motors>;
+using ball_repr2D = link_repr2D<ball_joint2D, &world_snapshot::balls>;
+} // namespace ppx
@@ -1,23 +1,31 @@
 #pragma once
 
 #include "ppx/joints/prismatic_joint.hpp"
-#include "lynx/drawing/line.hpp"
 #include "ppx-app/drawables/joints/joint_repr.hpp"
-#include "lynx/app/window.hpp"
+#include "ppx-app/threading/world_snapshot.hpp"
 
 namespace ppx
 {
 class prismatic_repr2D final : public joint_repr2D
 {
   public:
+    using joint_type = prismatic_joint2D;
+    static inline constexpr auto snapshot = &world_snapshot::prismatics;
+
     prismatic_repr2D(const prismatic_joint2D *pj, const lynx::color &color, float sleep_greyout);
 
+    void update(float sleep_greyout);
+    void update(const joint_state &state, float sleep_greyout);
+    joint_state state() const;
+    void draw(joint_batches2D &batches) const;
+
+    const prismatic_joint2D *joint() const;
+
   private:
     const prismatic_joint2D *m_pj;
-    lynx::thin_line2D m_line;
+    glm::vec2 m_anchor1;
+    glm::vec2 m_anchor2;
     lynx::color m_color;
-
-    void update(float sleep_greyout) override;
-    void draw(lynx::window2D &window) const override;
+    lynx::color m_current_color;
 };
-} // namespace ppx
\ No newline at end of file
+} // namespace ppx
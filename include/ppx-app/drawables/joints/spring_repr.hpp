@@ -2,21 +2,36 @@
 
 #include "ppx-app/drawables/lines/spring_line.hpp"
 #include "ppx-app/drawables/joints/joint_repr.hpp"
+#include "ppx-app/threading/world_snapshot.hpp"
 #include "ppx/joints/spring_joint.hpp"
 
+#include <span>
+
 namespace ppx
 {
 class spring_repr2D final : public joint_repr2D
 {
   public:
+    using joint_type = spring_joint2D;
+    static inline constexpr auto snapshot = &world_snapshot::springs;
+
     spring_repr2D(const spring_joint2D *sj, const lynx::color &color, float sleep_greyout);
 
+    void update(float sleep_greyout);
+    void update(const joint_state &state, float sleep_greyout);
+    // Rebuilds the zig-zags of the detailed representations together
+    static void update(std::span<spring_repr2D *const> reprs, std::span<const joint_state> states, float sleep_greyout);
+    joint_state state() const;
+    void draw(joint_batches2D &batches) const;
+
+    const spring_joint2D *joint() const;
+    const spring_line2D &line() const;
+
   private:
     const spring_joint2D *m_sj;
     spring_line2D m_line;
     lynx::color m_color;
-
-    void update(float sleep_greyout) override;
-    void draw(lynx::window2D &window) const override;
+    glm::vec2 m_anchor1;
+    glm::vec2 m_anchor2;
 };
-} // namespace ppx
\ No newline at end of file
+} // namespace ppx
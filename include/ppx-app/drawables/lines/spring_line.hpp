@@ -3,6 +3,8 @@
 #include "lynx/drawing/drawable.hpp"
 #include "lynx/drawing/line.hpp"
 #include "lynx/app/window.hpp"
+#include "ppx-app/drawables/batches/line_batch.hpp"
+#include "kit/memory/ptr/scope.hpp"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -13,6 +15,8 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/rotate_vector.hpp>
 
+#include <span>
+
 namespace ppx
 {
 class spring_line2D final : public lynx::line2D
@@ -23,6 +27,8 @@ class spring_line2D final : public lynx::line2D
     spring_line2D(const lynx::color &color, std::size_t supports_count = 6);
 
     void draw(lynx::window2D &window) const override;
+    // Appends the zig-zag to a line batch, so that any amount of springs is drawn in a single call
+    void draw(line_batch2D &batch) const;
 
     const glm::vec2 &p1() const override;
     const glm::vec2 &p2() const override;
@@ -30,6 +36,13 @@ class spring_line2D final : public lynx::line2D
     void p1(const glm::vec2 &p1) override;
     void p2(const glm::vec2 &p2) override;
 
+    // Moves both endpoints with a single rebuild of the zig-zag
+    void points(const glm::vec2 &p1, const glm::vec2 &p2);
+
+    // Same as calling points() on every line, with the per spring parameters computed in vectorizable passes
+    static void rebuild_batch(std::span<spring_line2D *const> lines, std::span<const glm::vec2> p1s,
+                              std::span<const glm::vec2> p2s);
+
     const lynx::color &color() const override;
     void color(const lynx::color &color) override;
 
@@ -47,6 +60,9 @@ class spring_line2D final : public lynx::line2D
     void right_padding(float right_padding);
     void min_height(float min_height);
 
+    // Bytes of the zig-zag's points. The line strip draw(window) uses is created on its first call
+    std::size_t memory() const;
+
   private:
     std::size_t m_supports_count;
     float m_supports_length = 0.8f;
@@ -54,9 +70,13 @@ class spring_line2D final : public lynx::line2D
     float m_right_padding = 0.f;
     float m_min_height = 1.f;
 
-    lynx::line_strip2D m_line_strip;
+    std::vector<glm::vec2> m_points;
+    lynx::color m_color;
+    const kit::transform2D<float> *m_parent = nullptr;
+    mutable kit::scope<lynx::line_strip2D> m_line_strip;
 
-    std::vector<glm::vec2> build_line_points(const glm::vec2 &p1, const glm::vec2 &p2);
     void update_line_points(const glm::vec2 &p1, const glm::vec2 &p2);
+    void write_line_points(const glm::vec2 &p1, const glm::vec2 &p2, const glm::vec2 &dir, float base_length,
+                           float height);
 };
 } // namespace ppx
@@ -1,9 +1,10 @@
 #pragma once
 
 #include "lynx/drawing/drawable.hpp"
-#include "lynx/drawing/shape.hpp"
 #include "lynx/drawing/line.hpp"
 #include "lynx/app/window.hpp"
+#include "ppx-app/drawables/batches/capsule_batch.hpp"
+#include "kit/memory/ptr/scope.hpp"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -16,6 +17,7 @@
 
 namespace ppx
 {
+// Drawn as a single capsule primitive, either on its own or as part of a capsule_batch2D
 class thick_line2D final : public lynx::line2D
 {
   public:
@@ -24,12 +26,14 @@ class thick_line2D final : public lynx::line2D
     thick_line2D(const lynx::color &color, float width = 1.f);
 
     void draw(lynx::window2D &window) const override;
+    void draw(capsule_batch2D &batch) const;
 
     const glm::vec2 &p1() const override;
     const glm::vec2 &p2() const override;
 
     void p1(const glm::vec2 &p1) override;
     void p2(const glm::vec2 &p2) override;
+    void points(const glm::vec2 &p1, const glm::vec2 &p2);
 
     const lynx::color &color() const override;
     void color(const lynx::color &color) override;
@@ -41,12 +45,14 @@ class thick_line2D final : public lynx::line2D
     void width(float width);
 
   private:
-    lynx::rect2D m_rect;
-    lynx::ellipse2D m_circle1;
-    lynx::ellipse2D m_circle2;
-
-    void update_width(float width);
-    void update_length();
-    void update_orientation();
+    glm::vec2 m_p1;
+    glm::vec2 m_p2;
+    lynx::color m_color;
+    float m_width;
+    const kit::transform2D<float> *m_parent = nullptr;
+
+    // Only created when the line is drawn on its own instead of through a batch
+    mutable kit::scope<capsule_batch2D> m_mesh;
+    mutable bool m_mesh_dirty = true;
 };
 } // namespace ppx
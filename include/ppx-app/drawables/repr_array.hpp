@@ -0,0 +1,145 @@
+#pragma once
+
+#include "kit/debug/log.hpp"
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+
+namespace ppx
+{
+// Packed representations of engine elements, addressed by meta.index and removed with the engine's swap-and-pop
+template <typename Repr> class repr_array
+{
+  public:
+    using value_type = Repr;
+    using iterator = typename std::vector<Repr>::iterator;
+    using const_iterator = typename std::vector<Repr>::const_iterator;
+
+    static inline constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    template <class... ReprArgs> Repr &emplace(const std::size_t index, ReprArgs &&...args)
+    {
+        KIT_ASSERT_ERROR(!contains(index), "A representation already exists for index {0}", index);
+        if (index >= m_index_to_dense.size())
+            m_index_to_dense.resize(index + 1, npos);
+
+        m_index_to_dense[index] = m_reprs.size();
+        m_dense_to_index.push_back(index);
+        return m_reprs.emplace_back(std::forward<ReprArgs>(args)...);
+    }
+
+    // last is the engine index of the element that will be moved into index once the engine removes it
+    void erase(const std::size_t index, const std::size_t last)
+    {
+        if (contains(index))
+        {
+            const std::size_t slot = m_index_to_dense[index];
+            const std::size_t back = m_reprs.size() - 1;
+            if (slot != back)
+            {
+                m_reprs[slot] = std::move(m_reprs[back]);
+                m_dense_to_index[slot] = m_dense_to_index[back];
+                m_index_to_dense[m_dense_to_index[slot]] = slot;
+            }
+            m_reprs.pop_back();
+            m_dense_to_index.pop_back();
+            m_index_to_dense[index] = npos;
+        }
+
+        if (index != last && last < m_index_to_dense.size())
+        {
+            const std::size_t slot = m_index_to_dense[last];
+            m_index_to_dense[index] = slot;
+            if (slot != npos)
+                m_dense_to_index[slot] = index;
+        }
+        if (last < m_index_to_dense.size())
+            m_index_to_dense.resize(last);
+    }
+
+    bool contains(const std::size_t index) const
+    {
+        return index < m_index_to_dense.size() && m_index_to_dense[index] != npos;
+    }
+
+    Repr &operator[](const std::size_t index)
+    {
+        KIT_ASSERT_ERROR(contains(index), "No representation exists for index {0}", index);
+        return m_reprs[m_index_to_dense[index]];
+    }
+    const Repr &operator[](const std::size_t index) const
+    {
+        KIT_ASSERT_ERROR(contains(index), "No representation exists for index {0}", index);
+        return m_reprs[m_index_to_dense[index]];
+    }
+
+    Repr *find(const std::size_t index)
+    {
+        return contains(index) ? &m_reprs[m_index_to_dense[index]] : nullptr;
+    }
+    const Repr *find(const std::size_t index) const
+    {
+        return contains(index) ? &m_reprs[m_index_to_dense[index]] : nullptr;
+    }
+
+    void reserve(const std::size_t capacity)
+    {
+        m_reprs.reserve(capacity);
+        m_dense_to_index.reserve(capacity);
+    }
+    void clear()
+    {
+        m_reprs.clear();
+        m_dense_to_index.clear();
+        m_index_to_dense.clear();
+    }
+
+    iterator begin()
+    {
+        return m_reprs.begin();
+    }
+    iterator end()
+    {
+        return m_reprs.end();
+    }
+    const_iterator begin() const
+    {
+        return m_reprs.begin();
+    }
+    const_iterator end() const
+    {
+        return m_reprs.end();
+    }
+
+    Repr *data()
+    {
+        return m_reprs.data();
+    }
+    const Repr *data() const
+    {
+        return m_reprs.data();
+    }
+
+    std::size_t size() const
+    {
+        return m_reprs.size();
+    }
+    bool empty() const
+    {
+        return m_reprs.empty();
+    }
+
+    // Bytes reserved by the dense storage and the index tables, not counting any memory the representations own
+    std::size_t memory() const
+    {
+        return m_reprs.capacity() * sizeof(Repr) +
+               (m_dense_to_index.capacity() + m_index_to_dense.capacity()) * sizeof(std::size_t);
+    }
+
+  private:
+    std::vector<Repr> m_reprs;
+    std::vector<std::size_t> m_dense_to_index;
+    std::vector<std::size_t> m_index_to_dense;
+};
+} // namespace ppx
@@ -1,21 +1,60 @@
 #pragma once
 
 #include "ppx/collider/collider.hpp"
+#include "ppx-app/drawables/batches/collider_batch.hpp"
+#include "ppx-app/threading/world_snapshot.hpp"
+#include "ppx-app/drawables/update_tracker.hpp"
+#include "ppx-app/drawables/shapes/polygon_mesh.hpp"
 #include "lynx/drawing/color.hpp"
-#include "lynx/drawing/shape.hpp"
-#include "lynx/app/window.hpp"
 
 namespace ppx
 {
-class collider_repr2D final : public lynx::drawable2D
+// Plain collider data, drawn through a collider_batch2D
+class collider_repr2D
 {
   public:
-    collider_repr2D(collider2D *collider, const lynx::color &color, float sleep_greyout);
     collider2D *collider;
-    kit::scope<lynx::shape2D> shape;
     lynx::color color;
 
     void update(float sleep_greyout);
-    void draw(lynx::window2D &window) const override;
+
+    // Incremental updates, skipped when the collider's body stayed asleep and its color did not change
+    void update(float sleep_greyout, std::uint64_t frame);
+    void update(const collider_state &state, float sleep_greyout, std::uint64_t frame);
+    void mark_dirty();
+
+    const glm::mat3 &transform() const;
+    const lynx::color &display_color() const;
+
+  protected:
+    collider_repr2D(collider2D *collider, const lynx::color &color);
+
+    glm::mat3 m_transform{1.f};
+    lynx::color m_display_color;
+    lynx::color m_applied_color;
+    update_tracker m_tracker;
+
+    void apply_color(bool asleep, float sleep_greyout);
+};
+
+class circle_repr2D final : public collider_repr2D
+{
+  public:
+    circle_repr2D(collider2D *collider, const lynx::color &color, float sleep_greyout);
+
+    float radius;
+
+    void draw(collider_batch2D &batch) const;
+};
+
+class polygon_repr2D final : public collider_repr2D
+{
+  public:
+    polygon_repr2D(collider2D *collider, polygon_mesh_cache &meshes, const lynx::color &color, float sleep_greyout);
+
+    // Shared with every other polygon with the same model vertices
+    polygon_mesh_cache::handle mesh;
+
+    void draw(collider_batch2D &batch) const;
 };
-} // namespace ppx
\ No newline at end of file
+} // namespace ppx
@@ -0,0 +1,87 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_INTRINSICS
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+namespace ppx
+{
+// Local space outline of a polygon collider, shared by every collider with the same model vertices
+struct polygon_mesh
+{
+    std::vector<glm::vec2> vertices;
+    // Largest distance from the local origin to a vertex
+    float radius = 0.f;
+};
+
+// Deduplicates polygon meshes by their model vertices, freeing each once its last handle is gone
+class polygon_mesh_cache
+{
+  public:
+    class handle
+    {
+      public:
+        handle() = default;
+        ~handle();
+
+        handle(handle &&other) noexcept;
+        handle &operator=(handle &&other) noexcept;
+
+        handle(const handle &) = delete;
+        handle &operator=(const handle &) = delete;
+
+        const polygon_mesh &mesh() const;
+        std::uint32_t id() const;
+
+      private:
+        polygon_mesh_cache *m_cache = nullptr;
+        std::uint32_t m_id = 0;
+
+        handle(polygon_mesh_cache *cache, std::uint32_t id);
+        void release();
+
+        friend class polygon_mesh_cache;
+    };
+
+    polygon_mesh_cache() = default;
+
+    polygon_mesh_cache(const polygon_mesh_cache &) = delete;
+    polygon_mesh_cache &operator=(const polygon_mesh_cache &) = delete;
+
+    template <typename It> handle acquire(It first, const It last)
+    {
+        m_scratch.clear();
+        for (; first != last; ++first)
+            m_scratch.push_back(*first);
+        return acquire_scratch();
+    }
+
+    // Unique meshes alive, handles pointing to them, and bytes held by their vertices
+    std::size_t size() const;
+    std::size_t references() const;
+    std::size_t memory() const;
+
+  private:
+    struct entry
+    {
+        polygon_mesh mesh;
+        std::size_t hash = 0;
+        std::uint32_t references = 0;
+    };
+
+    std::vector<entry> m_entries;
+    std::vector<std::uint32_t> m_free;
+    std::unordered_multimap<std::size_t, std::uint32_t> m_lookup;
+    std::vector<glm::vec2> m_scratch;
+    std::size_t m_references = 0;
+
+    handle acquire_scratch();
+    void release(std::uint32_t id);
+};
+} // namespace ppx
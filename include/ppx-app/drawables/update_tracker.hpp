@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ppx
+{
+// Lets representations of elements that stayed asleep skip their per-frame update
+class update_tracker
+{
+  public:
+    bool up_to_date(const bool asleep, const float sleep_greyout, const std::uint64_t frame)
+    {
+        if (m_dirty || !asleep || !m_asleep || sleep_greyout != m_sleep_greyout || m_frame + 1 != frame)
+            return false;
+        m_frame = frame;
+        return true;
+    }
+
+    void updated(const bool asleep, const float sleep_greyout, const std::uint64_t frame)
+    {
+        m_asleep = asleep;
+        m_sleep_greyout = sleep_greyout;
+        m_frame = frame;
+        m_dirty = false;
+    }
+
+    void mark_dirty()
+    {
+        m_dirty = true;
+    }
+
+  private:
+    std::uint64_t m_frame = 0;
+    float m_sleep_greyout = 0.f;
+    bool m_asleep = false;
+    bool m_dirty = true;
+};
+} // namespace ppx
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <limits>
+#include <cstdint>
+#include <string_view>
+
+#define PPX_PROFILE_CONCAT_IMPL(a, b) a##b
+#define PPX_PROFILE_CONCAT(a, b) PPX_PROFILE_CONCAT_IMPL(a, b)
+#define PPX_PROFILE_SCOPE(name) const ::ppx::profile_scope PPX_PROFILE_CONCAT(ppx_profile_scope_, __LINE__)(name);
+
+namespace ppx
+{
+// Ring of the main thread's nested scope timings per frame. Scopes from other threads are ignored, and ImGui rendering,
+// which runs in lynx's frame loop, only counts towards the frame total
+class frame_profiler
+{
+  public:
+    static inline constexpr std::size_t capacity = 240;
+    static inline constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    struct scope_record
+    {
+        const char *name;
+        std::uint32_t depth;
+        // Both in milliseconds, start being relative to the beginning of the frame
+        float start;
+        float duration;
+    };
+
+    struct frame_record
+    {
+        std::vector<scope_record> scopes;
+        float duration = 0.f;
+    };
+
+    struct scope_stats
+    {
+        std::string_view name;
+        std::uint32_t depth;
+        float last;
+        float average;
+        float p50;
+        float p99;
+    };
+
+    static bool enabled();
+    static void enabled(bool enabled);
+
+    static void begin_frame();
+    static std::size_t begin_scope(const char *name);
+    static void end_scope(std::size_t index);
+
+    // Completed frames only. An age of 0 is the most recently completed frame
+    static std::size_t frame_count();
+    static const frame_record &frame(std::size_t age);
+
+    // Per scope name statistics, with scopes sharing a name within a frame added together
+    static void compute_stats(std::vector<scope_stats> &stats);
+    static void compute_frame_stats(scope_stats &stats);
+
+    // Bytes held by the frame ring and the scopes of every frame in it
+    static std::size_t memory();
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    static inline bool s_enabled = false;
+    static inline bool s_recording = false;
+    static inline std::thread::id s_owner;
+    static inline clock::time_point s_frame_start;
+    static inline std::uint32_t s_depth = 0;
+
+    static inline std::vector<frame_record> s_frames{capacity};
+    static inline std::size_t s_head = 0;
+    static inline std::size_t s_count = 0;
+
+    static float elapsed();
+};
+
+class profile_scope
+{
+  public:
+    profile_scope(const char *name);
+    ~profile_scope();
+
+    profile_scope(const profile_scope &) = delete;
+    profile_scope &operator=(const profile_scope &) = delete;
+
+  private:
+    std::size_t m_index;
+};
+} // namespace ppx
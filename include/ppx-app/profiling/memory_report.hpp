@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <string_view>
+
+namespace ppx
+{
+// Bytes the app holds on top of the engine, by subsystem and element type. GPU bytes are estimates
+class memory_report
+{
+  public:
+    struct entry
+    {
+        std::string subsystem;
+        std::string name;
+        std::size_t count = 0;
+        std::size_t cpu_bytes = 0;
+        std::size_t gpu_bytes = 0;
+    };
+
+    // A limit of 0 disables it
+    struct budget
+    {
+        std::size_t cpu_bytes = 0;
+        std::size_t gpu_bytes = 0;
+    };
+
+    void clear();
+    void add(std::string_view subsystem, std::string_view name, std::size_t count, std::size_t cpu_bytes,
+             std::size_t gpu_bytes = 0);
+
+    const std::vector<entry> &entries() const;
+
+    std::size_t cpu_bytes() const;
+    std::size_t gpu_bytes() const;
+    bool exceeds(const budget &limits) const;
+
+  private:
+    std::vector<entry> m_entries;
+};
+
+template <typename T> std::size_t vector_bytes(const std::vector<T> &vector)
+{
+    return vector.capacity() * sizeof(T);
+}
+} // namespace ppx
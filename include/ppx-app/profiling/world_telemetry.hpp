@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ppx/world.hpp"
+#include "ppx-app/threading/job_pool.hpp"
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+namespace ppx
+{
+struct telemetry_sample
+{
+    std::uint64_t step = 0;
+    // Milliseconds spent in the sampled step
+    float step_time = 0.f;
+    float timestep = 0.f;
+
+    std::uint32_t bodies = 0;
+    std::uint32_t sleeping_bodies = 0;
+    std::uint32_t colliders = 0;
+    std::uint32_t contacts = 0;
+    std::uint32_t islands = 0;
+    float kinetic_energy = 0.f;
+};
+
+// Ring of world statistics with a single writer. Slot sequence numbers let readers drop copies torn by a write
+class world_telemetry
+{
+  public:
+    static inline constexpr std::size_t capacity = 4096;
+
+    std::atomic<bool> enabled{true};
+    // Only every interval-th step is sampled
+    std::atomic<std::uint32_t> interval{1};
+    std::size_t grain = 4096;
+
+    // Writer side. Must be called right after a step by the thread that stepped the world
+    void sample(const world2D &world, job_pool &jobs, kit::perf::time step_time);
+    // For callers that must not run pool jobs
+    void sample(const world2D &world, kit::perf::time step_time);
+
+    // Copies the retained samples, oldest first. Samples overwritten while being copied are left out
+    void read(std::vector<telemetry_sample> &samples) const;
+    std::uint64_t total_samples() const;
+
+    bool write_csv(const std::filesystem::path &path) const;
+    std::size_t memory() const;
+
+  private:
+    struct slot
+    {
+        std::atomic<std::uint64_t> sequence{0};
+        telemetry_sample sample;
+    };
+    struct partial
+    {
+        std::uint32_t sleeping_bodies;
+        double kinetic_energy;
+    };
+
+    std::vector<slot> m_slots{capacity};
+    std::atomic<std::uint64_t> m_written{0};
+
+    std::uint64_t m_steps = 0;
+    std::vector<partial> m_partials;
+
+    bool due();
+    std::size_t prepare(const world2D &world);
+    void reduce(const world2D &world, std::size_t start, std::size_t end, partial &result) const;
+    void finish(const world2D &world, kit::perf::time step_time);
+    void push(const telemetry_sample &sample);
+};
+} // namespace ppx
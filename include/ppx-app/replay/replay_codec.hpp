@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ppx-app/threading/world_snapshot.hpp"
+
+#include <span>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace ppx
+{
+// Turns world snapshots into quantized replay frames and back: keyframes hold absolute values, and delta frames the
+// 16 bit differences of the elements that changed
+class replay_codec
+{
+  public:
+    static inline constexpr std::uint32_t version = 2;
+
+    enum class frame_type : std::uint32_t
+    {
+        KEY = 0,
+        DELTA = 1
+    };
+
+    struct file_header
+    {
+        char magic[4];
+        std::uint32_t version;
+        float position_step;
+        float rotation_step;
+        std::uint32_t keyframe_interval;
+        std::uint32_t reserved;
+    };
+
+    struct frame_header
+    {
+        frame_type type;
+        std::uint32_t size;
+        // Colliders, then every joint type in snapshot_joint_states order
+        std::array<std::uint32_t, 1 + snapshot_joint_states.size()> counts;
+    };
+
+    static inline constexpr char magic[4] = {'P', 'P', 'X', 'R'};
+
+    replay_codec(float position_step = 1.f / 4096.f, float rotation_step = 1.f / 8192.f);
+
+    void encode(const world_snapshot &snapshot, bool force_key, frame_header &header, std::vector<std::byte> &payload);
+    bool decode(const frame_header &header, std::span<const std::byte> payload);
+    void reset();
+
+    // Writes the last frame into a snapshot, pointing each state to the world element with the same index
+    void fill(world2D &world, world_snapshot &snapshot) const;
+
+    float position_step() const;
+    float rotation_step() const;
+
+    // Bytes held by the tracks of the last frame and the scratch tracks
+    std::size_t memory() const;
+
+  private:
+    struct track
+    {
+        std::uint32_t channels;
+        std::vector<std::int32_t> values;
+        std::vector<std::uint8_t> asleep;
+
+        std::uint32_t count() const;
+    };
+
+    std::array<track, 1 + snapshot_joint_states.size()> m_tracks;
+    std::array<track, 1 + snapshot_joint_states.size()> m_scratch;
+    float m_position_step;
+    float m_rotation_step;
+
+    void quantize(const world_snapshot &snapshot);
+    float step(std::size_t track, std::uint32_t channel) const;
+};
+} // namespace ppx
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ppx-app/replay/replay_codec.hpp"
+
+#include <fstream>
+#include <filesystem>
+#include <limits>
+
+namespace ppx
+{
+// Reads a replay stream with random access, seeking from the closest keyframe before the requested frame
+class replay_player
+{
+  public:
+    static inline constexpr std::uint64_t npos = std::numeric_limits<std::uint64_t>::max();
+
+    bool open(const std::filesystem::path &path);
+    void close();
+    bool is_open() const;
+
+    bool seek(std::uint64_t frame);
+    bool advance();
+
+    // The current frame, or npos if none has been decoded yet
+    std::uint64_t frame() const;
+    std::uint64_t frame_count() const;
+
+    void fill(world2D &world, world_snapshot &snapshot) const;
+
+    // Bytes held by the frame and keyframe indices, the payload buffer and the codec
+    std::size_t memory() const;
+
+  private:
+    struct frame_entry
+    {
+        std::uint64_t offset;
+        replay_codec::frame_header header;
+    };
+
+    std::ifstream m_file;
+    replay_codec m_codec;
+    std::vector<frame_entry> m_frames;
+    std::vector<std::uint64_t> m_keyframes;
+    std::vector<std::byte> m_payload;
+    std::uint64_t m_frame = npos;
+
+    bool decode(std::uint64_t frame);
+};
+} // namespace ppx
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ppx-app/replay/replay_codec.hpp"
+
+#include <fstream>
+#include <filesystem>
+
+namespace ppx
+{
+// Streams replay frames to disk as they are encoded, so interrupted recordings stay readable
+class replay_recorder
+{
+  public:
+    struct specs
+    {
+        // Frames between forced keyframes, which bounds the work needed to seek to any frame
+        std::uint32_t keyframe_interval = 120;
+        float position_step = 1.f / 4096.f;
+        float rotation_step = 1.f / 8192.f;
+    };
+
+    bool open(const std::filesystem::path &path);
+    bool open(const std::filesystem::path &path, const specs &spc);
+    void close();
+    bool recording() const;
+
+    void record(const world_snapshot &snapshot);
+
+    std::uint64_t frame_count() const;
+    std::uint64_t keyframe_count() const;
+    std::uint64_t bytes_written() const;
+
+    // Bytes held by the payload buffer and the codec
+    std::size_t memory() const;
+
+  private:
+    std::ofstream m_file;
+    replay_codec m_codec;
+    std::uint32_t m_keyframe_interval = 120;
+
+    replay_codec::frame_header m_header;
+    std::vector<std::byte> m_payload;
+
+    std::uint64_t m_frames = 0;
+    std::uint64_t m_keyframes = 0;
+    std::uint64_t m_bytes = 0;
+};
+} // namespace ppx
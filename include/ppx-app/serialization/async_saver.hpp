@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ppx-app/serialization/binary_snapshot.hpp"
+
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <string>
+#include <functional>
+#include <condition_variable>
+
+namespace ppx
+{
+// Packs and writes captured snapshots on a dedicated thread, renaming each file into place once complete. .yaml and
+// .yml paths are written as YAML scenes. Callbacks run on the thread that calls poll()
+class async_saver
+{
+  public:
+    struct result
+    {
+        std::filesystem::path path;
+        bool success = false;
+        std::string error;
+        std::size_t bytes = 0;
+        // Time spent on the main thread capturing the state, and on the saving thread packing and writing it
+        kit::perf::time capture_time;
+        kit::perf::time write_time;
+    };
+    using callback = std::function<void(const result &)>;
+
+    async_saver(std::size_t memory_limit = 256 * 1024 * 1024);
+    ~async_saver();
+
+    async_saver(const async_saver &) = delete;
+    async_saver &operator=(const async_saver &) = delete;
+
+    // Saves that would push the memory held by queued saves past this are rejected through on_error, unless the queue
+    // is empty
+    bool save(const simulation &sim, const binary_snapshot::view_state &view, const std::filesystem::path &path,
+              callback on_complete = {}, callback on_error = {});
+
+    // Runs the callbacks of the saves that finished since the last call
+    void poll();
+    // Blocks until every queued save is written, then runs their callbacks
+    void wait();
+
+    std::size_t pending() const;
+    std::size_t buffered_bytes() const;
+
+    std::size_t memory_limit() const;
+    void memory_limit(std::size_t limit);
+
+  private:
+    struct request
+    {
+        binary_snapshot::contents contents;
+        // Bytes of the records plus the packed buffer, released once written
+        std::size_t size;
+        result res;
+        callback on_complete;
+        callback on_error;
+    };
+
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_queued;
+    std::condition_variable m_idle;
+    std::deque<request> m_requests;
+    std::deque<request> m_finished;
+    std::size_t m_buffered = 0;
+    std::size_t m_memory_limit;
+    bool m_writing = false;
+    bool m_running = true;
+
+    void run();
+    bool admits(std::size_t size) const;
+    bool admits_locked(std::size_t size) const;
+    static void reject(request &req);
+    static void write(request &req);
+    static void dispatch(const request &req);
+};
+} // namespace ppx
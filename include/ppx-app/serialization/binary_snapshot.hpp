@@ -0,0 +1,260 @@
+#pragma once
+
+#include "ppx-app/app/simulation.hpp"
+#include "ppx/joints/spring_joint.hpp"
+#include "ppx/joints/distance_joint.hpp"
+#include "ppx/joints/prismatic_joint.hpp"
+#include "ppx/joints/revolute_joint.hpp"
+#include "ppx/joints/weld_joint.hpp"
+#include "ppx/joints/rotor_joint.hpp"
+#include "ppx/joints/motor_joint.hpp"
+#include "ppx/joints/ball_joint.hpp"
+#include "kit/serialization/yaml/serializer.hpp"
+
+#include <span>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+namespace ppx
+{
+// Properties of a joint type as its specs hold them, or an empty struct for joint types without any
+template <typename Joint> struct snapshot_joint_properties
+{
+    struct type
+    {
+    };
+};
+template <typename Joint>
+    requires requires(typename Joint::specs spc) { spc.props; }
+struct snapshot_joint_properties<Joint>
+{
+    using type = decltype(Joint::specs::props);
+};
+
+// Versioned binary format for the world and app state: a header, a section table and aligned arrays of fixed size
+// records. Snapshots of other versions or with unknown sections are rejected
+class binary_snapshot
+{
+  public:
+    static inline constexpr std::uint32_t version = 2;
+    static inline constexpr std::uint32_t byte_order = 0x01020304;
+
+    // App state that does not belong to a simulation
+    struct view_state
+    {
+        glm::vec2 camera_position{0.f};
+        glm::vec2 camera_scale{1.f};
+        float camera_rotation = 0.f;
+        std::uint32_t framerate = 0;
+        // The lynx app node, kept as YAML text so that it survives conversions between formats
+        std::string lynx_app;
+    };
+
+    enum class section_id : std::uint32_t
+    {
+        APP = 1,
+        BODIES = 2,
+        COLLIDERS = 3,
+        VERTICES = 4,
+        SPRINGS = 5,
+        DISTANCES = 6,
+        LYNX_APP = 7,
+        PRISMATICS = 8,
+        REVOLUTES = 9,
+        WELDS = 10,
+        ROTORS = 11,
+        MOTORS = 12,
+        BALLS = 13,
+        ENGINE = 14
+    };
+
+    struct header
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t section_count;
+        std::uint64_t size;
+        std::uint64_t reserved;
+    };
+
+    struct section
+    {
+        section_id id;
+        std::uint32_t stride;
+        std::uint64_t count;
+        std::uint64_t offset;
+    };
+
+    struct app_record
+    {
+        float camera_position[2];
+        float camera_scale[2];
+        float camera_rotation;
+        float sleep_greyout;
+        float sync_speed;
+        float timestep;
+        float collider_color[4];
+        float joint_color[4];
+        std::uint32_t integrations_per_frame;
+        std::uint32_t framerate;
+        std::uint32_t paused;
+        std::uint32_t sync_timestep;
+    };
+
+    struct body_record
+    {
+        float position[2];
+        float velocity[2];
+        float rotation;
+        float angular_velocity;
+        std::uint32_t type;
+        std::uint32_t first_collider;
+        std::uint32_t collider_count;
+        std::uint32_t reserved;
+    };
+
+    struct collider_record
+    {
+        float position[2];
+        float rotation;
+        float radius;
+        float density;
+        float charge;
+        float friction;
+        float restitution;
+        float color[4];
+        std::uint32_t shape;
+        std::uint32_t sensor;
+        std::uint32_t first_vertex;
+        std::uint32_t vertex_count;
+    };
+
+    struct vertex_record
+    {
+        float position[2];
+    };
+
+    // The part every joint type shares
+    struct joint_record
+    {
+        std::uint32_t body1;
+        std::uint32_t body2;
+        float anchor1[2];
+        float anchor2[2];
+        std::uint32_t bodies_collide;
+        std::uint32_t reserved;
+    };
+
+    // Stored as the engine lays them out, so snapshots of another layout fail the stride check
+    template <typename Joint> struct typed_joint_record
+    {
+        using properties = typename snapshot_joint_properties<Joint>::type;
+        static_assert(std::is_trivially_copyable_v<properties>);
+
+        joint_record joint;
+        properties props;
+    };
+
+    template <typename Joint, section_id Id> struct joint_table
+    {
+        using joint_type = Joint;
+        static inline constexpr section_id id = Id;
+        std::vector<typed_joint_record<Joint>> records;
+    };
+
+    // In snapshot_joint_states order
+    using joint_tables = std::tuple<
+        joint_table<spring_joint2D, section_id::SPRINGS>, joint_table<distance_joint2D, section_id::DISTANCES>,
+        joint_table<prismatic_joint2D, section_id::PRISMATICS>, joint_table<revolute_joint2D, section_id::REVOLUTES>,
+        joint_table<weld_joint2D, section_id::WELDS>, joint_table<rotor_joint2D, section_id::ROTORS>,
+        joint_table<motor_joint2D, section_id::MOTORS>, joint_table<ball_joint2D, section_id::BALLS>>;
+
+    // The records of a snapshot before packing, which can then happen on any thread
+    struct contents
+    {
+        app_record app;
+        std::vector<body_record> bodies;
+        std::vector<collider_record> colliders;
+        std::vector<vertex_record> vertices;
+        joint_tables joints;
+        std::vector<char> lynx_app;
+        // Integrator, behaviours, collision and island settings as YAML text. Empty when YAML support is disabled
+        std::vector<char> engine;
+
+        // Bytes held by the records
+        std::size_t size() const;
+        // Every joint table one after the other, the order insert_joints() indexes them in
+        std::size_t joint_count() const;
+
+        // fn(table) is called with every joint table, in joint_tables order
+        template <typename F> void for_each_joint_table(F &&fn)
+        {
+            std::apply([&fn](auto &...tables) { (fn(tables), ...); }, joints);
+        }
+        template <typename F> void for_each_joint_table(F &&fn) const
+        {
+            std::apply([&fn](const auto &...tables) { (fn(tables), ...); }, joints);
+        }
+    };
+
+    static contents capture(const simulation &sim, const view_state &view);
+    static std::vector<std::byte> pack(const contents &cnt);
+    // Exact size of the data pack() returns
+    static std::size_t packed_size(const contents &cnt);
+    // Approximate size of the data write() would return, without the engine settings text
+    static std::size_t estimate(const simulation &sim, const view_state &view);
+
+    static std::vector<std::byte> write(const simulation &sim, const view_state &view);
+
+    // Replaces the world's contents. Returns false, leaving the world untouched, if the data is not a valid snapshot
+    static bool read(std::span<const std::byte> data, simulation &sim, view_state &view);
+
+    // The two halves of read(). Parsing touches no simulation. Insertion goes begin, bodies, joints and finish, under
+    // the world lock and with no other changes to the world in between
+    static bool parse(std::span<const std::byte> data, contents &cnt);
+    static void begin_insertion(const contents &cnt, simulation &sim, view_state &view);
+    static void insert_bodies(const contents &cnt, simulation &sim, std::size_t first, std::size_t last);
+    static void insert_joints(const contents &cnt, world2D &world, std::size_t first, std::size_t last);
+    static void finish_insertion(const contents &cnt, world2D &world);
+
+    // For worlds outside of any simulation. No lock is taken, so the world must not be stepped meanwhile
+    static contents capture(const world2D &world);
+    static void insert(const contents &cnt, world2D &world);
+    static bool read(std::span<const std::byte> data, world2D &world);
+
+    static bool save(const std::filesystem::path &path, std::span<const std::byte> data);
+    static bool load(const std::filesystem::path &path, std::vector<std::byte> &data);
+
+#ifdef KIT_USE_YAML_CPP
+    // Conversions to and from app::encode() nodes. They touch no simulation, so they can run on any thread
+    static bool parse(const YAML::Node &node, contents &cnt);
+    static bool from_yaml(const YAML::Node &node, std::vector<std::byte> &data);
+    static YAML::Node to_yaml(std::span<const std::byte> data);
+    static YAML::Node to_yaml(const contents &cnt);
+#endif
+
+  private:
+    static bool validate(std::span<const std::byte> data);
+    static bool find(std::span<const std::byte> data, section_id id, std::size_t stride, section &sct);
+
+    template <typename T> static std::vector<T> copy_section(std::span<const std::byte> data, const section_id id)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::vector<T> records;
+        section sct;
+        if (find(data, id, sizeof(T), sct))
+        {
+            records.resize(sct.count);
+            std::memcpy(records.data(), data.data() + sct.offset, sct.count * sizeof(T));
+        }
+        return records;
+    }
+};
+} // namespace ppx
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "ppx-app/serialization/binary_snapshot.hpp"
+
+#include <thread>
+#include <atomic>
+#include <string>
+
+namespace ppx
+{
+// Parses scenes on a dedicated thread and inserts them over several update() calls. The simulation is kept paused and
+// must not be modified until the load ends
+class scene_loader
+{
+  public:
+    enum class status
+    {
+        IDLE = 0,
+        PARSING = 1,
+        INSERTING = 2,
+        FINISHED = 3,
+        FAILED = 4,
+        CANCELLED = 5
+    };
+
+    // Seconds of insertion per update() call. At least grain bodies or joints are inserted per call
+    float budget = 0.004f;
+    std::size_t grain = 32;
+
+    scene_loader() = default;
+    ~scene_loader();
+
+    scene_loader(const scene_loader &) = delete;
+    scene_loader &operator=(const scene_loader &) = delete;
+
+    // Returns false if a load is already in progress
+    bool load(const std::filesystem::path &path);
+
+    // Called from the simulation's thread. Returns true, filling the scene's view state, once the load finishes
+    bool update(simulation &sim, binary_snapshot::view_state &view);
+
+    // A partially inserted world is cleared on the next update() call
+    void cancel();
+
+    status state() const;
+    bool loading() const;
+    // Fraction of bodies and joints inserted so far. Stays at 0 while parsing
+    float progress() const;
+
+    const std::filesystem::path &path() const;
+    const std::string &error() const;
+
+  private:
+    std::thread m_thread;
+    status m_status = status::IDLE;
+    // The loading thread only writes the error and the contents, and sets m_parsed once done with them
+    std::atomic<bool> m_parsed{false};
+    std::atomic<bool> m_cancelled{false};
+
+    std::filesystem::path m_path;
+    std::string m_error;
+    binary_snapshot::contents m_contents;
+
+    binary_snapshot::view_state m_view;
+    std::size_t m_bodies = 0;
+    std::size_t m_joints = 0;
+    std::size_t m_total = 0;
+    bool m_paused = false;
+
+    void parse(std::filesystem::path path);
+    void finish(status result);
+    void join();
+};
+} // namespace ppx
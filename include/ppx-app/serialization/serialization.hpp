@@ -10,12 +10,17 @@ template <> struct kit::yaml::codec<ppx::app>
 {
     static YAML::Node encode(const ppx::app &app)
     {
+        // Goes through the view state so that headless apps keep the camera and lynx app of the scene they loaded
+        const ppx::binary_snapshot::view_state view = app.snapshot_view();
+
         YAML::Node node;
-        node["Lynx app"] = kit::yaml::codec<lynx::app2D>::encode(app);
+        node["Lynx app"] = view.lynx_app.empty() ? YAML::Node{} : YAML::Load(view.lynx_app);
 
         node["Engine"] = app.world;
-        for (const auto &[collider, crepr] : app.shapes())
-            node["Shape colors"][collider->meta.index] = crepr.color;
+        for (const ppx::circle_repr2D &crepr : app.circles())
+            node["Shape colors"][crepr.collider->meta.index] = crepr.color;
+        for (const ppx::polygon_repr2D &prepr : app.polygons())
+            node["Shape colors"][prepr.collider->meta.index] = prepr.color;
         node["Sleep greyout"] = app.sleep_greyout;
         node["Paused"] = app.paused;
         node["Sync timestep"] = app.sync_timestep;
@@ -23,10 +28,10 @@ template <> struct kit::yaml::codec<ppx::app>
         node["Collider color"] = app.collider_color;
         node["Joints color"] = app.joint_color;
         node["Integrations per frame"] = app.integrations_per_frame;
-        node["Framerate"] = app.framerate_cap();
-        node["Camera position"] = app.window()->camera()->transform.position;
-        node["Camera scale"] = app.window()->camera()->transform.scale;
-        node["Camera rotation"] = app.window()->camera()->transform.rotation;
+        node["Framerate"] = view.framerate;
+        node["Camera position"] = view.camera_position;
+        node["Camera scale"] = view.camera_scale;
+        node["Camera rotation"] = view.camera_rotation;
         return node;
     }
     static bool decode(const YAML::Node &node, ppx::app &app)
@@ -37,23 +42,30 @@ template <> struct kit::yaml::codec<ppx::app>
         app.collider_color = node["Collider color"].as<lynx::color>();
         app.joint_color = node["Joints color"].as<lynx::color>();
 
-        kit::yaml::codec<lynx::app2D>::decode(node["Lynx app"], app);
         node["Engine"].as<ppx::world2D>(app.world);
 
         app.sleep_greyout = node["Sleep greyout"].as<float>();
-        if (node["Shape colors"])
-            for (auto &[collider, repr] : app.shapes())
-                app.color(collider, node["Shape colors"][collider->meta.index].as<lynx::color>());
+        if (const YAML::Node colors = node["Shape colors"])
+        {
+            for (const ppx::circle_repr2D &crepr : app.circles())
+                app.color(crepr.collider, colors[crepr.collider->meta.index].as<lynx::color>());
+            for (const ppx::polygon_repr2D &prepr : app.polygons())
+                app.color(prepr.collider, colors[prepr.collider->meta.index].as<lynx::color>());
+        }
 
         app.paused = node["Paused"].as<bool>();
         app.sync_timestep = node["Sync timestep"].as<bool>();
         app.sync_speed = node["Sync speed"].as<float>();
         app.integrations_per_frame = node["Integrations per frame"].as<std::uint32_t>();
-        app.limit_framerate(node["Framerate"].as<std::uint32_t>());
 
-        app.window()->camera()->transform.position = node["Camera position"].as<glm::vec2>();
-        app.window()->camera()->transform.scale = node["Camera scale"].as<glm::vec2>();
-        app.window()->camera()->transform.rotation = node["Camera rotation"].as<float>();
+        ppx::binary_snapshot::view_state view;
+        view.framerate = node["Framerate"].as<std::uint32_t>();
+        view.camera_position = node["Camera position"].as<glm::vec2>();
+        view.camera_scale = node["Camera scale"].as<glm::vec2>();
+        view.camera_rotation = node["Camera rotation"].as<float>();
+        if (const YAML::Node lynx_app = node["Lynx app"]; lynx_app && !lynx_app.IsNull())
+            view.lynx_app = YAML::Dump(lynx_app);
+        app.apply_view(view);
         return true;
     }
 };
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "kit/memory/ptr/scope.hpp"
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace ppx
+{
+// Work-stealing job pool. Blocking calls help run pending jobs, so a pool with no workers runs them on the caller
+class job_pool
+{
+  public:
+    using job = std::function<void()>;
+
+    job_pool(std::size_t thread_count = default_thread_count());
+    ~job_pool();
+
+    job_pool(const job_pool &) = delete;
+    job_pool &operator=(const job_pool &) = delete;
+
+    static std::size_t default_thread_count();
+
+    // Submitted jobs must not throw
+    void submit(job jb);
+
+    // A grain of 0 picks one automatically. The first exception thrown by a chunk is rethrown once all chunks ran
+    template <typename F>
+    void parallel_for(const std::size_t begin, const std::size_t end, F &&fn, std::size_t grain = 0)
+    {
+        if (begin >= end)
+            return;
+        const std::size_t count = end - begin;
+        if (grain == 0)
+            grain = std::max<std::size_t>(1, count / (4 * (m_threads.size() + 1)));
+        if (m_threads.empty() || count <= grain)
+        {
+            fn(begin, end);
+            return;
+        }
+
+        const std::size_t chunks = (count + grain - 1) / grain;
+        std::atomic<std::size_t> remaining{chunks};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        for (std::size_t i = 0; i < chunks; i++)
+        {
+            const std::size_t start = begin + i * grain;
+            const std::size_t stop = std::min(start + grain, end);
+            submit([&fn, &remaining, &error, &error_mutex, start, stop]() {
+                // The chunk must be counted even if it throws, or wait() would never return
+                try
+                {
+                    fn(start, stop);
+                }
+                catch (...)
+                {
+                    std::scoped_lock lock(error_mutex);
+                    if (!error)
+                        error = std::current_exception();
+                }
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            });
+        }
+        wait(remaining);
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    template <typename C, typename F> void for_each(C &container, F &&fn, const std::size_t grain = 0)
+    {
+        auto first = container.begin();
+        parallel_for(
+            0, container.size(),
+            [&fn, first](const std::size_t start, const std::size_t end) {
+                for (auto it = first + start; it != first + end; ++it)
+                    fn(*it);
+            },
+            grain);
+    }
+
+    std::size_t thread_count() const;
+
+  private:
+    struct worker_queue
+    {
+        std::mutex mutex;
+        std::deque<job> jobs;
+    };
+
+    std::vector<std::thread> m_threads;
+    std::vector<kit::scope<worker_queue>> m_queues;
+
+    std::atomic<std::size_t> m_next_queue{0};
+    std::atomic<std::size_t> m_pending{0};
+    std::atomic<bool> m_running{true};
+
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_wake;
+
+    bool try_run_one(std::size_t preferred);
+    void wait(const std::atomic<std::size_t> &remaining);
+    void worker_loop(std::size_t index);
+};
+} // namespace ppx
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ppx/world.hpp"
+#include "ppx-app/threading/triple_buffer.hpp"
+#include "ppx-app/threading/world_snapshot.hpp"
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+namespace ppx
+{
+// Steps a world at a fixed rate on its own thread. Other threads reach the world through lock_world() while it runs
+class physics_thread
+{
+  public:
+    physics_thread(world2D &world, float rate);
+    ~physics_thread();
+
+    physics_thread(const physics_thread &) = delete;
+    physics_thread &operator=(const physics_thread &) = delete;
+
+    std::atomic<bool> paused{false};
+    // Called from the physics thread after every step, with the world locked and the step duration. Set before start()
+    std::function<void(kit::perf::time)> on_step;
+
+    void start();
+    void stop();
+    bool running() const;
+
+    void request_step();
+    std::unique_lock<std::mutex> lock_world();
+
+    // Render side: fetches the latest published snapshot, if any, keeping the one before it to interpolate from
+    bool consume(world_snapshot &previous, world_snapshot &current);
+    float interpolation(const world_snapshot &current) const;
+
+    float rate() const;
+    kit::perf::time step_time() const;
+
+    // Bytes held by the three published snapshots. The world must be locked
+    std::size_t memory() const;
+
+  private:
+    world2D &m_world;
+    float m_rate;
+
+    std::thread m_thread;
+    std::mutex m_world_mutex;
+    std::atomic<bool> m_running{false};
+    std::atomic<std::uint32_t> m_requested_steps{0};
+    std::atomic<kit::perf::time> m_step_time;
+
+    triple_buffer<world_snapshot> m_snapshots;
+
+    void run();
+    void publish();
+};
+} // namespace ppx
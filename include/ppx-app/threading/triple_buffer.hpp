@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ppx
+{
+// Single producer, single consumer triple buffer. Neither side ever blocks the other
+template <typename T> class triple_buffer
+{
+  public:
+    T &back()
+    {
+        return m_buffers[m_back];
+    }
+    const T &front() const
+    {
+        return m_buffers[m_front];
+    }
+    // All three buffers, for bookkeeping such as memory reports. The producer must not be publishing meanwhile
+    const std::array<T, 3> &buffers() const
+    {
+        return m_buffers;
+    }
+
+    // Producer side: hands the back buffer over to the consumer
+    void publish()
+    {
+        const std::uint8_t previous = m_middle.exchange(m_back | fresh_bit, std::memory_order_acq_rel);
+        m_back = previous & index_mask;
+    }
+
+    // Consumer side: returns true if a newer buffer was published since the last call
+    bool consume()
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & fresh_bit))
+            return false;
+        const std::uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & index_mask;
+        return true;
+    }
+
+  private:
+    static inline constexpr std::uint8_t fresh_bit = 4;
+    static inline constexpr std::uint8_t index_mask = 3;
+
+    std::array<T, 3> m_buffers;
+    std::uint8_t m_back = 0;
+    std::uint8_t m_front = 1;
+    std::atomic<std::uint8_t> m_middle{2};
+};
+} // namespace ppx
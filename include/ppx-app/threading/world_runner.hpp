@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ppx/world.hpp"
+#include "ppx-app/profiling/world_telemetry.hpp"
+#include "ppx-app/threading/job_pool.hpp"
+
+#include "kit/memory/ptr/scope.hpp"
+
+#include <string>
+#include <vector>
+#include <filesystem>
+
+namespace ppx
+{
+// Independent worlds for parameter sweeps, stepped concurrently with one job per world
+class world_runner
+{
+  public:
+    struct instance
+    {
+        instance(const ppx::specs::world2D &spc, const std::string &label);
+
+        world2D world;
+        std::string label;
+        world_telemetry telemetry;
+
+        std::uint64_t steps = 0;
+        double simulated_time = 0.0;
+        kit::perf::time step_time;
+    };
+
+    struct stats
+    {
+        // Wall time of the last step() call, and world steps completed per second during it
+        kit::perf::time wall_time;
+        float steps_per_second = 0.f;
+    };
+
+    bool paused = false;
+    std::uint32_t steps_per_update = 1;
+
+    // The returned world is ready to be populated. Worlds must not be added or removed while they are being stepped
+    world2D &add(const ppx::specs::world2D &spc, const std::string &label);
+    // Copies another world, which must not be stepped meanwhile
+    world2D &add(const world2D &source, const std::string &label);
+    // Adds a world holding the scene of a binary snapshot file. Returns nullptr, adding nothing, if it cannot be read
+    world2D *load(const std::filesystem::path &path, const std::string &label);
+    void remove(std::size_t index);
+    void clear();
+
+    // Steps every world steps_per_update times, blocking until all of them are done. Does nothing while paused
+    void step(job_pool &jobs);
+    // Steps every world the given amount of times, regardless of paused
+    void run(job_pool &jobs, std::uint64_t steps);
+
+    instance &operator[](std::size_t index);
+    const instance &operator[](std::size_t index) const;
+    std::size_t size() const;
+    bool empty() const;
+
+    const stats &statistics() const;
+
+    // One row per world. Each world's telemetry is written next to it, as <stem>_<index>.csv
+    bool write_csv(const std::filesystem::path &path) const;
+
+  private:
+    std::vector<kit::scope<instance>> m_instances;
+    stats m_stats;
+};
+} // namespace ppx
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "ppx/collider/collider.hpp"
+#include "ppx/joints/joint.hpp"
+#include "ppx-app/utility/bounds.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_INTRINSICS
+#include <glm/glm.hpp>
+
+#include <array>
+#include <vector>
+#include <chrono>
+
+namespace ppx
+{
+class world2D;
+
+struct collider_state
+{
+    const collider2D *collider = nullptr;
+    glm::vec2 position{0.f};
+    float rotation = 0.f;
+    bool asleep = false;
+    bounds2D bounds;
+
+    static collider_state from(const collider2D *collider);
+    static bounds2D bounds_of(const collider2D *collider);
+    static collider_state lerp(const collider_state &from, const collider_state &to, float alpha);
+
+    glm::mat3 transform() const;
+};
+
+struct joint_state
+{
+    const joint2D *joint = nullptr;
+    glm::vec2 anchor1{0.f};
+    glm::vec2 anchor2{0.f};
+    float value = 0.f;
+    bool asleep = false;
+
+    static joint_state lerp(const joint_state &from, const joint_state &to, float alpha);
+};
+
+// What the render thread needs from a world step, indexed by meta.index. The pointers detect entries made stale by
+// structural changes, which only happen under lock_world() on the render thread
+struct world_snapshot
+{
+    std::vector<collider_state> colliders;
+    std::vector<joint_state> springs;
+    std::vector<joint_state> distances;
+    std::vector<joint_state> prismatics;
+    std::vector<joint_state> revolutes;
+    std::vector<joint_state> welds;
+    std::vector<joint_state> rotors;
+    std::vector<joint_state> motors;
+    std::vector<joint_state> balls;
+
+    std::chrono::steady_clock::time_point published;
+
+    void capture(world2D &world);
+    void clear();
+    std::size_t memory() const;
+};
+
+// Every joint state array of a snapshot, in the fixed order the replay format relies on
+inline constexpr std::array<std::vector<joint_state> world_snapshot::*, 8> snapshot_joint_states{
+    &world_snapshot::springs,   &world_snapshot::distances, &world_snapshot::prismatics, &world_snapshot::revolutes,
+    &world_snapshot::welds,     &world_snapshot::rotors,    &world_snapshot::motors,     &world_snapshot::balls};
+// Display names of the joint state arrays, in the same order
+inline constexpr std::array<const char *, 8> snapshot_joint_names{"Springs", "Distances", "Prismatics", "Revolutes",
+                                                                   "Welds",   "Rotors",    "Motors",     "Balls"};
+} // namespace ppx
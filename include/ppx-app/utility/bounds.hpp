@@ -0,0 +1,43 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_INTRINSICS
+#include <glm/glm.hpp>
+
+namespace ppx
+{
+struct bounds2D
+{
+    glm::vec2 min{0.f};
+    glm::vec2 max{0.f};
+
+    glm::vec2 center() const
+    {
+        return 0.5f * (min + max);
+    }
+    glm::vec2 dimension() const
+    {
+        return max - min;
+    }
+
+    bool contains(const glm::vec2 &point) const
+    {
+        return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y;
+    }
+    bool intersects(const bounds2D &other) const
+    {
+        return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y;
+    }
+
+    bounds2D expanded(const float margin) const
+    {
+        return {min - margin, max + margin};
+    }
+    void enclose(const glm::vec2 &point)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+};
+} // namespace ppx
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ppx-app/utility/bounds.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace ppx
+{
+// Uniform grid over bounding boxes binned by their center. Entries much larger than a cell are always tested
+class spatial_grid2D
+{
+  public:
+    void clear();
+    void reserve(std::size_t capacity);
+    void insert(std::size_t id, const bounds2D &bounds);
+
+    // A cell size of 0 picks one from the average entry extent
+    void build(float cell_size = 0.f);
+
+    // fn(id) is called once for every entry whose bounds intersect the area
+    template <typename F> void query(const bounds2D &area, F &&fn) const
+    {
+        query_bounds(area, [&fn](const std::size_t id, const bounds2D &) { fn(id); });
+    }
+    template <typename F> void query(const glm::vec2 &point, F &&fn) const
+    {
+        query(bounds2D{point, point}, std::forward<F>(fn));
+    }
+
+    // Same as query(), but fn(id, bounds) also receives the bounds the entry was inserted with
+    template <typename F> void query_bounds(const bounds2D &area, F &&fn) const
+    {
+        for (const entry &e : m_oversized)
+            if (e.bounds.intersects(area))
+                fn(e.id, e.bounds);
+        if (m_sorted.empty())
+            return;
+
+        const bounds2D loose = area.expanded(m_margin);
+        const glm::ivec2 from = cell(loose.min);
+        const glm::ivec2 to = cell(loose.max);
+        for (std::int32_t y = from.y; y <= to.y; y++)
+            for (std::int32_t x = from.x; x <= to.x; x++)
+            {
+                const std::size_t c = static_cast<std::size_t>(y) * m_columns + static_cast<std::size_t>(x);
+                for (std::uint32_t i = m_cell_offsets[c]; i < m_cell_offsets[c + 1]; i++)
+                    if (m_sorted[i].bounds.intersects(area))
+                        fn(m_sorted[i].id, m_sorted[i].bounds);
+            }
+    }
+
+    // fn(cell, count) is called for every cell overlapping the area, with the amount of entries binned in it
+    template <typename F> void for_each_cell(const bounds2D &area, F &&fn) const
+    {
+        if (m_sorted.empty())
+            return;
+        const glm::ivec2 from = cell(area.min);
+        const glm::ivec2 to = cell(area.max);
+        for (std::int32_t y = from.y; y <= to.y; y++)
+            for (std::int32_t x = from.x; x <= to.x; x++)
+            {
+                const std::size_t c = static_cast<std::size_t>(y) * m_columns + static_cast<std::size_t>(x);
+                const glm::vec2 offset{static_cast<float>(x), static_cast<float>(y)};
+                const glm::vec2 min = m_area.min + m_cell_size * offset;
+                fn(bounds2D{min, min + m_cell_size}, m_cell_offsets[c + 1] - m_cell_offsets[c]);
+            }
+    }
+
+    std::size_t size() const;
+    std::size_t oversized() const;
+    float cell_size() const;
+    std::size_t memory() const;
+
+  private:
+    struct entry
+    {
+        std::size_t id;
+        bounds2D bounds;
+    };
+
+    std::vector<entry> m_entries;
+    std::vector<entry> m_sorted;
+    std::vector<entry> m_oversized;
+    std::vector<std::uint32_t> m_cell_offsets;
+    std::vector<std::uint32_t> m_cell_indices;
+
+    bounds2D m_area;
+    float m_cell_size = 1.f;
+    float m_margin = 0.f;
+    std::uint32_t m_columns = 0;
+    std::uint32_t m_rows = 0;
+
+    glm::ivec2 cell(const glm::vec2 &point) const;
+};
+} // namespace ppx
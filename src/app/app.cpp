@@ -1,10 +1,7 @@
 #include "ppx-app/internal/pch.hpp"
 #include "ppx-app/app/app.hpp"
 #include "ppx-app/serialization/serialization.hpp"
-#include "ppx-app/drawables/shapes/oriented_nsphere.hpp"
-#include "ppx-app/drawables/joints/distance_repr.hpp"
-#include "ppx-app/drawables/joints/spring_repr.hpp"
-#include "ppx-app/drawables/joints/prismatic_repr.hpp"
+#include "ppx-app/serialization/binary_snapshot.hpp"
 
 #include "lynx/geometry/camera.hpp"
 #include "ppx/joints/distance_joint.hpp"
@@ -12,67 +9,176 @@
 
 namespace ppx
 {
-app::app(const specs &spc) : lynx::app2D(spc.window), world(spc.world)
+app::app(const specs &spc) : simulation(spc), m_headless_run(spc.headless_run)
 {
-    world.add_builtin_joint_managers();
-    m_window = window();
-    push_layer<menu_layer>();
+    add_joint_callbacks();
+    if (spc.headless)
+        return;
+
+    m_host = kit::make_scope<window_host>(*this, spc.window);
+    m_window = m_host->window();
+    push_layer<menu_layer>(overlay);
+    push_layer<profiler_layer>(*this);
+    push_layer<replay_layer>(*this);
+    push_layer<telemetry_layer>(*this);
+    push_layer<worlds_layer>(*this);
+    push_layer<loader_layer>(m_loader);
 
     m_window->maintain_camera_aspect_ratio(true);
     m_camera = m_window->set_camera<lynx::orthographic2D>(m_window->pixel_aspect(), 50.f);
     m_camera->flip_y_axis();
+}
 
-    add_world_callbacks();
+app::~app()
+{
+    // The layers reference members declared after the host, so the window and its layers go first
+    m_host.reset();
 }
 
-void app::add_world_callbacks()
+app::window_host::window_host(app &owner, const lynx::window2D::specs &spc) : lynx::app2D(spc), m_app(owner)
 {
-    world.colliders.events.on_addition += [this](collider2D *collider) {
-        KIT_ASSERT_ERROR(!m_shapes.contains(collider), "Collider already exists in the app");
-        m_shapes.emplace(collider, collider_repr2D(collider, collider_color, sleep_greyout));
-    };
+}
 
-    world.colliders.events.on_removal += [this](collider2D &collider) {
-        KIT_ASSERT_ERROR(m_shapes.contains(&collider), "Collider does not exist in the app");
-        m_shapes.erase(&collider);
-    };
+void app::window_host::on_start()
+{
+    m_app.on_start();
+}
+void app::window_host::on_update(const float ts)
+{
+    m_app.on_update(ts);
+}
+void app::window_host::on_render(const float ts)
+{
+    m_app.on_render(ts);
+}
+void app::window_host::on_shutdown()
+{
+    m_app.on_shutdown();
+}
+bool app::window_host::on_event(const lynx::event2D &event)
+{
+    return m_app.on_event(event);
+}
 
-    world.joints.manager<spring_joint2D>()->events.on_addition += [this](spring_joint2D *sp) {
-        m_joints.emplace(sp, kit::make_scope<spring_repr2D>(sp, joint_color, sleep_greyout));
-    };
+void app::run()
+{
+    if (m_host)
+    {
+        m_host->run();
+        return;
+    }
+    on_start();
+    run_headless(m_headless_run);
+    on_shutdown();
+}
+
+void app::shutdown()
+{
+    if (m_host)
+        m_host->shutdown();
+    else
+        stop_headless();
+}
+
+bool app::headless() const
+{
+    return !m_host;
+}
+
+lynx::app2D *app::lynx_app()
+{
+    return m_host.get();
+}
+const lynx::app2D *app::lynx_app() const
+{
+    return m_host.get();
+}
 
-    world.joints.manager<distance_joint2D>()->events.on_addition +=
-        [this](distance_joint2D *dj) { m_joints.emplace(dj, kit::make_scope<distance_repr2D>(dj, sleep_greyout)); };
-    world.joints.manager<prismatic_joint2D>()->events.on_addition += [this](prismatic_joint2D *pj) {
-        m_joints.emplace(pj, kit::make_scope<prismatic_repr2D>(pj, joint_color, sleep_greyout));
+bool app::pop_layer(const lynx::layer2D *layer)
+{
+    return m_host && m_host->pop_layer(layer);
+}
+
+lynx::window2D *app::window()
+{
+    return m_window;
+}
+const lynx::window2D *app::window() const
+{
+    return m_window;
+}
+
+std::uint32_t app::framerate_cap() const
+{
+    return m_host ? m_host->framerate_cap() : m_detached_view.framerate;
+}
+void app::limit_framerate(const std::uint32_t framerate)
+{
+    if (m_host)
+        m_host->limit_framerate(framerate);
+    else
+        m_detached_view.framerate = framerate;
+}
+
+void app::add_joint_callbacks()
+{
+    m_joints.for_each_type([this](auto &reprs) { add_joint_callbacks(reprs); });
+}
+
+template <typename Repr> void app::add_joint_callbacks(repr_array<Repr> &reprs)
+{
+    using Joint = typename Repr::joint_type;
+    auto *manager = world.joints.manager<Joint>();
+    manager->events.on_addition += [this, &reprs](Joint *joint) {
+        // Distance joints are colored by their stress rather than by the shared joint color
+        if constexpr (std::is_same_v<Repr, distance_repr2D>)
+            reprs.emplace(joint->meta.index, joint, sleep_greyout);
+        else
+            reprs.emplace(joint->meta.index, joint, joint_color, sleep_greyout);
     };
+    manager->events.on_removal += [&reprs, manager](Joint &joint) {
+        reprs.erase(joint.meta.index, manager->size() - 1);
+    };
+}
 
-    world.joints.events.on_removal += [this](joint2D &joint) { m_joints.erase(&joint); };
+void app::reserve_joint_reprs(const std::type_index joint, const std::size_t count)
+{
+    m_joints.for_each_type([joint, count](auto &reprs) {
+        using Joint = typename std::remove_reference_t<decltype(reprs)>::value_type::joint_type;
+        if (joint == typeid(Joint))
+            reprs.reserve(reprs.size() + count);
+    });
 }
 
-void app::on_update(const float ts)
+void app::on_start()
 {
-    {
-        KIT_PERF_SCOPE("ppx::app::physics")
-        const kit::perf::clock physics_clock;
+}
+void app::on_shutdown()
+{
+}
 
-        if (sync_timestep)
-            world.integrator.ts.value = sync_speed * ts + (1.f - sync_speed) * world.integrator.ts.value;
+void app::on_update(const float ts)
+{
+    binary_snapshot::view_state loaded_view;
+    if (m_loader.update(*this, loaded_view))
+        apply_view(loaded_view);
 
-        if (!paused)
-            for (std::uint32_t i = 0; i < integrations_per_frame; i++)
-                world.step();
-        m_physics_time = physics_clock.elapsed();
-    }
-    update_shapes();
-    update_joints();
-    move_camera(ts);
+    if (!headless())
+        view(visible_area(), pixel_size());
+    simulation::on_update(ts);
+    if (update_reprs)
+        update_joints();
+    if (!headless())
+        move_camera(ts);
+    m_saver.poll();
 }
 
 void app::on_render(const float ts)
 {
+    PPX_PROFILE_SCOPE("ppx::app::render")
     draw_shapes();
     draw_joints();
+    draw_overlay();
 }
 
 bool app::on_event(const lynx::event2D &event)
@@ -92,7 +198,7 @@ bool app::on_event(const lynx::event2D &event)
             return true;
         case lynx::input2D::key::RIGHT:
             if (paused)
-                world.step();
+                single_step();
             return true;
         default:
             return false;
@@ -104,7 +210,7 @@ bool app::on_event(const lynx::event2D &event)
         {
         case lynx::input2D::key::RIGHT:
             if (paused)
-                world.step();
+                single_step();
             return true;
         default:
             return false;
@@ -120,31 +226,160 @@ bool app::on_event(const lynx::event2D &event)
     return false;
 }
 
-void app::update_shapes()
+void app::update_joints()
 {
-    for (auto &[collider, crepr] : m_shapes)
-        crepr.update(sleep_greyout);
+    PPX_PROFILE_SCOPE("ppx::app::update_joints")
+    m_joints.for_each_type([this](auto &reprs) { update_joint_reprs(reprs); });
 }
-void app::update_joints()
+
+template <typename Repr> void app::update_joint_reprs(repr_array<Repr> &reprs)
+{
+    const std::vector<joint_state> &previous = m_previous_snapshot.*Repr::snapshot;
+    const std::vector<joint_state> &current = m_current_snapshot.*Repr::snapshot;
+    const float greyout = sleep_greyout;
+    const std::uint64_t frame = m_frame;
+    const bool cull = frustum_culling;
+    const bounds2D area = m_view.expanded(joint_cull_margin);
+    const bool threaded = snapshot_driven();
+    const float min_detail_length = spring_detail_length * m_pixel_size;
+
+    // Returns whether the representation must be updated with the state, which is filled in that case
+    const auto prepare = [this, greyout, frame, cull, &area, threaded, min_detail_length, &previous,
+                          &current](Repr &jrepr, joint_state &state) {
+        const joint2D *joint = jrepr.joint();
+        if (threaded)
+        {
+            const std::size_t index = joint->meta.index;
+            if (index >= current.size() || current[index].joint != joint)
+                return false;
+            state = index < previous.size() && previous[index].joint == joint
+                        ? joint_state::lerp(previous[index], current[index], m_interpolation)
+                        : current[index];
+        }
+
+        // Picked from the bounds of the last update, so joints that skip this one need no anchors
+        const bool detailed = glm::length(jrepr.bounds.dimension()) >= min_detail_length;
+        if (detailed != jrepr.detailed)
+        {
+            jrepr.detailed = detailed;
+            jrepr.tracker.mark_dirty();
+        }
+
+        const bool asleep = threaded ? state.asleep : joint->asleep();
+        if (jrepr.tracker.up_to_date(asleep, greyout, frame))
+        {
+            jrepr.visible = !cull || jrepr.bounds.intersects(area);
+            return false;
+        }
+
+        if (!threaded)
+            state = jrepr.state();
+        jrepr.bounds = {glm::min(state.anchor1, state.anchor2), glm::max(state.anchor1, state.anchor2)};
+        jrepr.visible = !cull || jrepr.bounds.intersects(area);
+        return jrepr.visible;
+    };
+
+    // Springs are updated a chunk at a time, so that each chunk's zig-zags are rebuilt in a single batch
+    const auto first = reprs.begin();
+    const auto update = [&prepare, greyout, frame, first](const std::size_t start, const std::size_t end) {
+        thread_local std::vector<spring_repr2D *> springs;
+        thread_local std::vector<joint_state> spring_states;
+        springs.clear();
+        spring_states.clear();
+
+        for (auto it = first + start; it != first + end; ++it)
+        {
+            Repr &jrepr = *it;
+            joint_state state;
+            if (!prepare(jrepr, state))
+                continue;
+            if constexpr (std::is_same_v<Repr, spring_repr2D>)
+            {
+                springs.push_back(&jrepr);
+                spring_states.push_back(state);
+            }
+            else
+                jrepr.update(state, greyout);
+            jrepr.tracker.updated(state.asleep, greyout, frame);
+        }
+        if constexpr (std::is_same_v<Repr, spring_repr2D>)
+            spring_repr2D::update(springs, spring_states, greyout);
+    };
+    m_jobs.parallel_for(0, reprs.size(), update, update_grain);
+}
+
+void app::report_memory(memory_report &report) const
 {
-    for (auto &[joint, jrepr] : m_joints)
-        jrepr->update(sleep_greyout);
+    simulation::report_memory(report);
+    m_joints.for_each_type([&report](const auto &reprs) { report_joint_memory(report, reprs); });
+
+    report.add("Rendering", "Collider batch", 1, m_collider_batch.memory(), m_collider_batch.uploaded_bytes());
+    report.add("Rendering", "Capsule batch", 1, m_capsule_batch.memory(), m_capsule_batch.uploaded_bytes());
+    report.add("Rendering", "Line batch", 1, m_line_batch.memory(), m_line_batch.uploaded_bytes());
+    report.add("Rendering", "Debug overlay", 1, overlay.memory(), overlay.uploaded_bytes());
+    report.add("Serialization", "Pending saves", m_saver.pending(), m_saver.buffered_bytes());
 }
 
-void app::draw_shapes() const
+template <typename Repr> void app::report_joint_memory(memory_report &report, const repr_array<Repr> &reprs)
 {
-    for (const auto &[collider, crepr] : m_shapes)
-        m_window->draw(crepr);
+    std::size_t type = 0;
+    while (snapshot_joint_states[type] != Repr::snapshot)
+        type++;
+
+    // Joints draw through the shared batches, so only the springs' zig-zag points add to the storage
+    std::size_t cpu_bytes = reprs.memory();
+    if constexpr (std::is_same_v<Repr, spring_repr2D>)
+        for (const spring_repr2D &jrepr : reprs)
+            cpu_bytes += jrepr.line().memory();
+    report.add("Joints", snapshot_joint_names[type], reprs.size(), cpu_bytes, 0);
 }
 
-void app::draw_joints() const
+void app::draw_shapes()
 {
-    for (const auto &[joint, jrepr] : m_joints)
-        m_window->draw(*jrepr);
+    PPX_PROFILE_SCOPE("ppx::app::draw_shapes")
+    m_collider_batch.clear();
+    m_collider_batch.lod = shape_lod;
+    m_collider_batch.pixel_size(m_pixel_size);
+    for_each_visible_shape([this](const auto &crepr) { crepr.draw(m_collider_batch); }, false);
+    m_window->draw(m_collider_batch);
+}
+
+void app::draw_overlay()
+{
+    if (!overlay.enabled())
+        return;
+    PPX_PROFILE_SCOPE("ppx::app::draw_overlay")
+    // With threaded physics the engine views run a step ahead of the interpolated shapes
+    const auto lock = lock_world();
+    overlay.build(world, shape_grid(), m_view, m_pixel_size);
+    m_window->draw(overlay);
+}
+
+void app::draw_joints()
+{
+    PPX_PROFILE_SCOPE("ppx::app::draw_joints")
+    std::size_t visible = 0;
+    m_line_batch.clear();
+    m_capsule_batch.clear();
+    joint_batches2D batches{*m_window, m_line_batch, m_capsule_batch};
+    m_joints.for_each_type([&batches, &visible](const auto &reprs) {
+        for (const auto &jrepr : reprs)
+            if (jrepr.visible)
+            {
+                jrepr.draw(batches);
+                visible++;
+            }
+    });
+    m_window->draw(m_line_batch);
+    m_window->draw(m_capsule_batch);
+
+    m_culling.visible_joints = visible;
+    m_culling.culled_joints = m_joints.size() - visible;
 }
 
 void app::move_camera(const float ts)
 {
+    PPX_PROFILE_SCOPE("ppx::app::move_camera")
     if (ImGui::GetIO().WantCaptureKeyboard || lynx::input2D::key_pressed(lynx::input2D::key::LEFT_CONTROL) ||
         lynx::input2D::key_pressed(lynx::input2D::key::LEFT_SHIFT))
         return;
@@ -175,33 +410,114 @@ void app::zoom(const float offset)
     m_camera->transform.position += dpos;
 }
 
-kit::perf::time app::physics_time() const
-{
-    return m_physics_time;
-}
-
 glm::vec2 app::world_mouse_position() const
 {
+    if (!m_host)
+        return glm::vec2{0.f};
     const glm::vec2 mpos = lynx::input2D::mouse_position();
     return m_camera->screen_to_world(mpos);
 }
-const std::unordered_map<collider2D *, collider_repr2D> &app::shapes() const
+
+collider2D *app::collider_under_mouse()
 {
-    return m_shapes;
+    return collider_at(world_mouse_position());
 }
-void app::color(collider2D *collider, const lynx::color &color)
+
+bounds2D app::visible_area() const
 {
-    KIT_ASSERT_ERROR(m_shapes.contains(collider), "Collider does not exist in the app");
-    m_shapes.at(collider).color = color;
+    if (!m_host)
+        return m_view;
+    const glm::vec2 corner = m_camera->screen_to_world({-1.f, -1.f});
+    bounds2D area{corner, corner};
+    area.enclose(m_camera->screen_to_world({1.f, -1.f}));
+    area.enclose(m_camera->screen_to_world({-1.f, 1.f}));
+    area.enclose(m_camera->screen_to_world({1.f, 1.f}));
+    return area;
+}
+
+float app::pixel_size() const
+{
+    if (!m_host)
+        return m_pixel_size;
+    return visible_area().dimension().y / static_cast<float>(m_window->pixel_height());
+}
+
+binary_snapshot::view_state app::snapshot_view() const
+{
+    if (!m_host)
+        return m_detached_view;
+
+    binary_snapshot::view_state view;
+    view.camera_position = m_camera->transform.position;
+    view.camera_scale = m_camera->transform.scale;
+    view.camera_rotation = m_camera->transform.rotation;
+    view.framerate = framerate_cap();
+#ifdef KIT_USE_YAML_CPP
+    view.lynx_app = YAML::Dump(kit::yaml::codec<lynx::app2D>::encode(*m_host));
+#endif
+    return view;
+}
+
+bool app::save_snapshot(const std::filesystem::path &path) const
+{
+    return binary_snapshot::save(path, binary_snapshot::write(*this, snapshot_view()));
+}
+
+bool app::save_snapshot_async(const std::filesystem::path &path, async_saver::callback on_complete,
+                              async_saver::callback on_error)
+{
+    return m_saver.save(*this, snapshot_view(), path, std::move(on_complete), std::move(on_error));
+}
+async_saver &app::saver()
+{
+    return m_saver;
+}
+
+bool app::load_snapshot(const std::filesystem::path &path)
+{
+    std::vector<std::byte> data;
+    binary_snapshot::view_state view;
+    if (!binary_snapshot::load(path, data) || !binary_snapshot::read(data, *this, view))
+        return false;
+    apply_view(view);
+    return true;
+}
+
+bool app::load_snapshot_async(const std::filesystem::path &path)
+{
+    return m_loader.load(path);
+}
+scene_loader &app::loader()
+{
+    return m_loader;
+}
+
+void app::apply_view(const binary_snapshot::view_state &view)
+{
+    if (!m_host)
+    {
+        m_detached_view = view;
+        return;
+    }
+#ifdef KIT_USE_YAML_CPP
+    if (!view.lynx_app.empty())
+        kit::yaml::codec<lynx::app2D>::decode(YAML::Load(view.lynx_app), *m_host);
+#endif
+    limit_framerate(view.framerate);
+    m_camera->transform.position = view.camera_position;
+    m_camera->transform.scale = view.camera_scale;
+    m_camera->transform.rotation = view.camera_rotation;
 }
 
 #ifdef KIT_USE_YAML_CPP
 YAML::Node app::encode() const
 {
+    const auto lock = lock_world();
     return kit::yaml::codec<app>::encode(*this);
 }
 bool app::decode(const YAML::Node &node)
 {
+    const auto lock = lock_world();
     return kit::yaml::codec<app>::decode(node, *this);
 }
 #endif
@@ -0,0 +1,68 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/app/loader_layer.hpp"
+#include "ppx-app/serialization/scene_loader.hpp"
+
+namespace ppx
+{
+loader_layer::loader_layer(scene_loader &loader) : lynx::layer2D("Loader layer"), m_loader(loader)
+{
+}
+
+void loader_layer::on_render(const float ts)
+{
+    if (ImGui::BeginMainMenuBar())
+    {
+        if (ImGui::BeginMenu("File"))
+        {
+            ImGui::MenuItem("Load scene", nullptr, &m_visible);
+            ImGui::EndMenu();
+        }
+        ImGui::EndMainMenuBar();
+    }
+    if (m_loader.loading())
+        m_visible = true;
+    if (!m_visible)
+        return;
+
+    if (ImGui::Begin("Load scene", &m_visible))
+    {
+        ImGui::BeginDisabled(m_loader.loading());
+        ImGui::InputText("File", m_path.data(), m_path.size());
+        if (ImGui::Button("Load"))
+            m_loader.load(m_path.data());
+        ImGui::EndDisabled();
+        float budget = 1000.f * m_loader.budget;
+        if (ImGui::SliderFloat("Budget (ms)", &budget, 0.5f, 33.f, "%.1f"))
+            m_loader.budget = budget / 1000.f;
+        render_progress();
+    }
+    ImGui::End();
+}
+
+void loader_layer::render_progress()
+{
+    switch (m_loader.state())
+    {
+    case scene_loader::status::IDLE:
+        return;
+    case scene_loader::status::PARSING:
+        ImGui::Text("Parsing '%s'...", m_loader.path().string().c_str());
+        break;
+    case scene_loader::status::INSERTING:
+        ImGui::Text("Inserting '%s'...", m_loader.path().string().c_str());
+        break;
+    case scene_loader::status::FINISHED:
+        ImGui::Text("Loaded '%s'", m_loader.path().string().c_str());
+        break;
+    case scene_loader::status::FAILED:
+        ImGui::TextWrapped("%s", m_loader.error().c_str());
+        return;
+    case scene_loader::status::CANCELLED:
+        ImGui::Text("Load cancelled");
+        return;
+    }
+    ImGui::ProgressBar(m_loader.progress());
+    if (m_loader.loading() && ImGui::Button("Cancel"))
+        m_loader.cancel();
+}
+} // namespace ppx
@@ -1,12 +1,13 @@
 #include "ppx-app/internal/pch.hpp"
 #include "ppx-app/app/menu_layer.hpp"
+#include "ppx-app/profiling/frame_profiler.hpp"
 #include "lynx/app/app.hpp"
 #include "lynx/app/window.hpp"
 #include "lynx/geometry/camera.hpp"
 
 namespace ppx
 {
-menu_layer::menu_layer() : lynx::layer2D("Menu layer")
+menu_layer::menu_layer(debug_overlay2D &overlay) : lynx::layer2D("Menu layer"), m_overlay(overlay)
 {
 }
 
@@ -25,7 +26,43 @@ void menu_layer::on_render(const float ts)
                 m_window->close();
             ImGui::EndMenu();
         }
+        if (ImGui::BeginMenu("View"))
+        {
+            bool profiler = frame_profiler::enabled();
+            if (ImGui::MenuItem("Profiler", nullptr, &profiler))
+                frame_profiler::enabled(profiler);
+            render_overlay_menu();
+            ImGui::EndMenu();
+        }
         ImGui::EndMainMenuBar();
     }
 }
+
+void menu_layer::render_overlay_menu()
+{
+    if (!ImGui::BeginMenu("Overlays"))
+        return;
+    ImGui::MenuItem("Broad phase", nullptr, &m_overlay.show_broad_phase);
+    ImGui::MenuItem("Contact points", nullptr, &m_overlay.show_contacts);
+    ImGui::MenuItem("Islands", nullptr, &m_overlay.show_islands);
+    ImGui::Separator();
+    ImGui::MenuItem("Picking grid", nullptr, &m_overlay.show_grid);
+    ImGui::MenuItem("Bounding boxes", nullptr, &m_overlay.show_bounds);
+    ImGui::MenuItem("Overlaps", nullptr, &m_overlay.show_overlaps);
+    ImGui::MenuItem("Overlap groups", nullptr, &m_overlay.show_groups);
+
+    if (m_overlay.enabled())
+    {
+        const debug_overlay2D::stats &stats = m_overlay.statistics();
+        ImGui::Separator();
+        ImGui::Text("Broad phase cells in view: %zu", stats.broad_phase_cells);
+        ImGui::Text("Contact points in view: %zu", stats.contacts);
+        ImGui::Text("Islands in view: %zu", stats.islands);
+        ImGui::Text("Occupied cells: %zu (max %u per cell)", stats.cells, stats.max_occupancy);
+        ImGui::Text("Boxes in view: %zu", stats.bounds);
+        ImGui::Text("Overlaps: %zu%s", stats.overlaps, stats.truncated ? " (truncated)" : "");
+        ImGui::Text("Groups: %zu", stats.groups);
+    }
+    ImGui::EndMenu();
+}
 } // namespace ppx
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/app/profiler_layer.hpp"
+#include "ppx-app/app/simulation.hpp"
+
+namespace ppx
+{
+profiler_layer::profiler_layer(simulation &sim) : lynx::layer2D("Profiler layer"), m_sim(sim)
+{
+}
+
+void profiler_layer::on_render(const float ts)
+{
+    if (!frame_profiler::enabled())
+        return;
+
+    PPX_PROFILE_SCOPE("ppx::profiler_layer::render")
+    bool open = true;
+    if (ImGui::Begin("Profiler", &open))
+    {
+        frame_profiler::compute_stats(m_stats);
+        render_table();
+        render_timeline();
+        render_flame_view();
+        render_stepping();
+        render_memory();
+    }
+    ImGui::End();
+    if (!open)
+        frame_profiler::enabled(false);
+}
+
+void profiler_layer::render_table()
+{
+    frame_profiler::scope_stats frame;
+    frame_profiler::compute_frame_stats(frame);
+    ImGui::Text("Frames recorded: %zu", frame_profiler::frame_count());
+
+    if (!ImGui::BeginTable("Stages", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        return;
+    ImGui::TableSetupColumn("Stage");
+    ImGui::TableSetupColumn("Last (ms)");
+    ImGui::TableSetupColumn("Avg (ms)");
+    ImGui::TableSetupColumn("p50 (ms)");
+    ImGui::TableSetupColumn("p99 (ms)");
+    ImGui::TableHeadersRow();
+
+    const auto row = [](const frame_profiler::scope_stats &stats) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Indent(12.f * static_cast<float>(stats.depth) + 1.f);
+        ImGui::Text("%.*s", static_cast<int>(stats.name.size()), stats.name.data());
+        ImGui::Unindent(12.f * static_cast<float>(stats.depth) + 1.f);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", stats.last);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", stats.average);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", stats.p50);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", stats.p99);
+    };
+    row(frame);
+    for (const frame_profiler::scope_stats &stats : m_stats)
+        row(stats);
+    ImGui::EndTable();
+}
+
+void profiler_layer::render_timeline()
+{
+#ifdef LYNX_ENABLE_IMPLOT
+    const std::size_t count = frame_profiler::frame_count();
+    if (count == 0 || !ImPlot::BeginPlot("Timeline", ImVec2(-1.f, 200.f)))
+        return;
+    ImPlot::SetupAxes("Frame", "Time (ms)", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+
+    // Oldest frame first, so that time flows to the right
+    m_timeline.resize(count);
+    for (std::size_t i = 0; i < count; i++)
+        m_timeline[i] = frame_profiler::frame(count - 1 - i).duration;
+    ImPlot::PlotLine("Frame", m_timeline.data(), static_cast<int>(count));
+
+    for (const frame_profiler::scope_stats &stats : m_stats)
+    {
+        if (stats.depth != 0)
+            continue;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            float duration = 0.f;
+            for (const frame_profiler::scope_record &record : frame_profiler::frame(count - 1 - i).scopes)
+                if (stats.name == record.name)
+                    duration += record.duration;
+            m_timeline[i] = duration;
+        }
+        const std::string label{stats.name};
+        ImPlot::PlotLine(label.c_str(), m_timeline.data(), static_cast<int>(count));
+    }
+    ImPlot::EndPlot();
+#endif
+}
+
+void profiler_layer::render_flame_view() const
+{
+    if (frame_profiler::frame_count() == 0 || !ImGui::CollapsingHeader("Last frame"))
+        return;
+
+    const frame_profiler::frame_record &frame = frame_profiler::frame(0);
+    if (frame.duration <= 0.f)
+        return;
+
+    constexpr float row_height = 20.f;
+    std::uint32_t depth = 0;
+    for (const frame_profiler::scope_record &record : frame.scopes)
+        depth = std::max(depth, record.depth + 1);
+
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = ImGui::GetContentRegionAvail().x;
+    ImDrawList *draw_list = ImGui::GetWindowDrawList();
+
+    const float scale = width / frame.duration;
+    for (const frame_profiler::scope_record &record : frame.scopes)
+    {
+        const ImVec2 min{origin.x + record.start * scale, origin.y + static_cast<float>(record.depth) * row_height};
+        const ImVec2 max{min.x + std::max(record.duration * scale, 1.f), min.y + row_height - 1.f};
+        const ImU32 color = ImColor::HSV(0.6f - 0.12f * static_cast<float>(record.depth % 5), 0.5f, 0.8f);
+        draw_list->AddRectFilled(min, max, color);
+        draw_list->PushClipRect(min, max, true);
+        draw_list->AddText(ImVec2(min.x + 3.f, min.y + 3.f), IM_COL32_BLACK, record.name);
+        draw_list->PopClipRect();
+        if (ImGui::IsMouseHoveringRect(min, max))
+            ImGui::SetTooltip("%s: %.3f ms", record.name, record.duration);
+    }
+    ImGui::Dummy(ImVec2(width, static_cast<float>(depth) * row_height));
+}
+
+void profiler_layer::render_stepping()
+{
+    if (!ImGui::CollapsingHeader("Stepping"))
+        return;
+    if (m_sim.threaded_physics())
+    {
+        ImGui::Text("Physics run on their own thread at a fixed rate");
+        return;
+    }
+
+    substep_controller &controller = m_sim.substeps;
+    ImGui::Checkbox("Adaptive substeps", &controller.enabled);
+    if (!controller.enabled)
+        return;
+
+    float budget = 1000.f * controller.budget;
+    if (ImGui::SliderFloat("Budget (ms)", &budget, 0.5f, 33.f, "%.1f"))
+        controller.budget = budget / 1000.f;
+    float timestep = 1000.f * controller.timestep;
+    if (ImGui::SliderFloat("Timestep (ms)", &timestep, 1.f, 1000.f * controller.max_timestep, "%.2f"))
+        controller.timestep = timestep / 1000.f;
+    ImGui::SliderFloat("Max catch up (s)", &controller.max_catch_up, 0.f, 1.f, "%.2f");
+
+    const substep_controller::stats &stats = controller.statistics();
+    ImGui::Text("Real time factor: %.2f", stats.real_time_factor);
+    ImGui::ProgressBar(std::min(stats.budget_usage, 1.f), ImVec2(-1.f, 0.f), "Budget usage");
+    ImGui::Text("Substeps: %u x %.2f ms (%.3f ms each)", stats.substeps, 1000.f * stats.timestep,
+                1000.f * stats.substep_cost);
+    ImGui::Text("Backlog: %.1f ms, dropped: %.2f s", 1000.f * stats.backlog, stats.dropped_time);
+}
+
+void profiler_layer::render_memory()
+{
+    if (!ImGui::CollapsingHeader("Memory"))
+        return;
+
+    constexpr float mb = 1024.f * 1024.f;
+    const auto to_mb = [](const std::size_t bytes) { return static_cast<float>(bytes) / mb; };
+    m_memory.clear();
+    m_sim.report_memory(m_memory);
+    ImGui::Text("Total: %.2f MB CPU, %.2f MB GPU (estimated)", to_mb(m_memory.cpu_bytes()),
+                to_mb(m_memory.gpu_bytes()));
+
+    // Limits are edited in megabytes, where 0 disables them
+    float cpu_limit = to_mb(m_sim.memory_budget.cpu_bytes);
+    float gpu_limit = to_mb(m_sim.memory_budget.gpu_bytes);
+    if (ImGui::DragFloat("CPU budget (MB)", &cpu_limit, 1.f, 0.f, FLT_MAX, "%.0f"))
+        m_sim.memory_budget.cpu_bytes = static_cast<std::size_t>(std::max(cpu_limit, 0.f) * mb);
+    if (ImGui::DragFloat("GPU budget (MB)", &gpu_limit, 1.f, 0.f, FLT_MAX, "%.0f"))
+        m_sim.memory_budget.gpu_bytes = static_cast<std::size_t>(std::max(gpu_limit, 0.f) * mb);
+    if (m_memory.exceeds(m_sim.memory_budget))
+        ImGui::TextColored(ImVec4(1.f, 0.35f, 0.3f, 1.f), "Over budget");
+
+    if (!ImGui::BeginTable("Memory", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        return;
+    ImGui::TableSetupColumn("Subsystem");
+    ImGui::TableSetupColumn("Type");
+    ImGui::TableSetupColumn("Count");
+    ImGui::TableSetupColumn("CPU (KB)");
+    ImGui::TableSetupColumn("GPU (KB)");
+    ImGui::TableHeadersRow();
+    for (const memory_report::entry &entry : m_memory.entries())
+    {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Text("%s", entry.subsystem.c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%s", entry.name.c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", entry.count);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", static_cast<float>(entry.cpu_bytes) / 1024.f);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", static_cast<float>(entry.gpu_bytes) / 1024.f);
+    }
+    ImGui::EndTable();
+}
+} // namespace ppx
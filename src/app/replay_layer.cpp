@@ -0,0 +1,86 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/app/replay_layer.hpp"
+#include "ppx-app/app/simulation.hpp"
+
+namespace ppx
+{
+replay_layer::replay_layer(simulation &sim) : lynx::layer2D("Replay layer"), m_sim(sim)
+{
+}
+
+void replay_layer::on_render(const float ts)
+{
+    if (ImGui::BeginMainMenuBar())
+    {
+        if (ImGui::BeginMenu("View"))
+        {
+            ImGui::MenuItem("Replay", nullptr, &m_visible);
+            ImGui::EndMenu();
+        }
+        ImGui::EndMainMenuBar();
+    }
+    if (!m_visible)
+        return;
+
+    if (ImGui::Begin("Replay", &m_visible))
+    {
+        ImGui::InputText("File", m_path.data(), m_path.size());
+        render_recorder();
+        ImGui::Separator();
+        render_player();
+    }
+    ImGui::End();
+}
+
+void replay_layer::render_recorder()
+{
+    replay_recorder &recorder = m_sim.recorder;
+    if (recorder.recording())
+    {
+        if (ImGui::Button("Stop recording"))
+            recorder.close();
+        ImGui::Text("Frames: %llu (%llu keyframes)", static_cast<unsigned long long>(recorder.frame_count()),
+                    static_cast<unsigned long long>(recorder.keyframe_count()));
+        ImGui::Text("Size: %.2f MB (%.1f bytes per frame)", static_cast<float>(recorder.bytes_written()) / 1048576.f,
+                    recorder.frame_count() == 0 ? 0.f
+                                                : static_cast<float>(recorder.bytes_written()) /
+                                                      static_cast<float>(recorder.frame_count()));
+        return;
+    }
+
+    ImGui::BeginDisabled(m_sim.player.is_open());
+    if (ImGui::Button("Record") && !recorder.open(m_path.data()))
+        KIT_ERROR("Failed to open replay file '{0}' for recording", m_path.data());
+    ImGui::EndDisabled();
+}
+
+void replay_layer::render_player()
+{
+    replay_player &player = m_sim.player;
+    if (!player.is_open())
+    {
+        ImGui::BeginDisabled(m_sim.recorder.recording());
+        if (ImGui::Button("Open replay") && !player.open(m_path.data()))
+            KIT_ERROR("Failed to open replay file '{0}'", m_path.data());
+        ImGui::EndDisabled();
+        return;
+    }
+
+    if (ImGui::Button(m_sim.paused ? "Play" : "Pause"))
+        m_sim.paused = !m_sim.paused;
+    ImGui::SameLine();
+    if (ImGui::Button("Close replay"))
+        player.close();
+    if (!player.is_open() || player.frame_count() == 0)
+        return;
+
+    const std::uint64_t last = player.frame_count() - 1;
+    std::uint64_t frame = player.frame() == replay_player::npos ? 0 : player.frame();
+    const std::uint64_t min = 0;
+    if (ImGui::SliderScalar("Frame", ImGuiDataType_U64, &frame, &min, &last))
+    {
+        m_sim.paused = true;
+        player.seek(frame);
+    }
+}
+} // namespace ppx
@@ -0,0 +1,570 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/app/simulation.hpp"
+
+namespace ppx
+{
+simulation::simulation() : simulation(specs{})
+{
+}
+simulation::simulation(const specs &spc) : world(spc.world), m_jobs(spc.worker_threads)
+{
+    world.add_builtin_joint_managers();
+    add_collider_callbacks();
+    if (spc.threaded_physics)
+    {
+        m_physics_thread = kit::make_scope<physics_thread>(world, spc.physics_rate);
+        m_physics_thread->on_step = [this](const kit::perf::time step_time) {
+            telemetry.sample(world, step_time);
+        };
+    }
+}
+
+void simulation::add_collider_callbacks()
+{
+    world.colliders.events.on_addition += [this](collider2D *collider) {
+        m_shape_grid_valid = false;
+        if (m_batch_depth > 0)
+            m_batched_colliders.push_back(collider);
+        else
+            add_collider_repr(collider);
+    };
+
+    world.colliders.events.on_removal += [this](collider2D &collider) {
+        flush_batched_colliders();
+        const std::size_t index = collider.meta.index;
+        KIT_ASSERT_ERROR(m_circles.contains(index) || m_polygons.contains(index), "Collider does not exist in the app");
+
+        const std::size_t last = world.colliders.size() - 1;
+        m_shape_grid_valid = false;
+        m_circles.erase(index, last);
+        m_polygons.erase(index, last);
+    };
+}
+
+void simulation::add_collider_repr(collider2D *collider)
+{
+    const std::size_t index = collider->meta.index;
+    KIT_ASSERT_ERROR(!m_circles.contains(index) && !m_polygons.contains(index), "Collider already exists in the app");
+    if (collider->shape_if<circle>())
+        m_circles.emplace(index, collider, collider_color, sleep_greyout);
+    else
+        m_polygons.emplace(index, collider, m_meshes, collider_color, sleep_greyout);
+}
+
+simulation::batch_guard::batch_guard(simulation &sim, const std::size_t expected_colliders) : m_sim(sim)
+{
+    m_sim.m_batched_colliders.reserve(m_sim.m_batched_colliders.size() + expected_colliders);
+    m_sim.m_batch_depth++;
+}
+
+simulation::batch_guard::~batch_guard()
+{
+    KIT_ASSERT_ERROR(m_sim.m_batch_depth > 0, "No batch is open");
+    if (--m_sim.m_batch_depth == 0)
+        m_sim.flush_batched_colliders();
+}
+
+simulation::batch_guard simulation::batch(const std::size_t expected_colliders)
+{
+    return batch_guard{*this, expected_colliders};
+}
+
+bool simulation::batching() const
+{
+    return m_batch_depth > 0;
+}
+
+void simulation::flush_batched_colliders()
+{
+    if (m_batched_colliders.empty())
+        return;
+    KIT_PERF_SCOPE("ppx::simulation::flush_batched_colliders")
+    std::size_t circles = 0;
+    for (const collider2D *collider : m_batched_colliders)
+        if (collider->shape_if<circle>())
+            circles++;
+    m_circles.reserve(m_circles.size() + circles);
+    m_polygons.reserve(m_polygons.size() + m_batched_colliders.size() - circles);
+
+    for (collider2D *collider : m_batched_colliders)
+        add_collider_repr(collider);
+    m_batched_colliders.clear();
+}
+
+void simulation::add_bodies(const std::vector<ppx::specs::body2D> &bodies)
+{
+    std::size_t colliders = 0;
+    for (const ppx::specs::body2D &spc : bodies)
+        colliders += spc.props.colliders.size();
+
+    const auto lock = lock_world();
+    const batch_guard guard{*this, colliders};
+    for (const ppx::specs::body2D &spc : bodies)
+        world.bodies.add(spc);
+}
+
+void simulation::reserve_joint_reprs(const std::type_index, const std::size_t)
+{
+}
+
+void simulation::on_update(const float ts)
+{
+    frame_profiler::begin_frame();
+    m_frame++;
+    bool new_snapshot = false;
+    if (player.is_open())
+        play_replay();
+    else if (m_physics_thread)
+        new_snapshot = sync_physics_thread();
+    else
+        step_physics(ts);
+    if (recorder.recording() && !player.is_open())
+        record_replay(new_snapshot);
+    sweep.step(m_jobs);
+    check_memory_budget();
+    m_shape_grid_valid = false;
+    if (!update_reprs)
+        return;
+    update_visibility();
+    update_shapes();
+}
+
+void simulation::run_headless()
+{
+    run_headless(headless_specs{});
+}
+void simulation::run_headless(const headless_specs &spc)
+{
+    using clock = std::chrono::steady_clock;
+    KIT_ASSERT_ERROR(spc.rate >= 0.f, "Headless rate must be non-negative");
+
+    const auto period = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<float>(spc.rate > 0.f ? 1.f / spc.rate : 0.f));
+    auto next = clock::now();
+
+    m_headless_running = true;
+    for (std::uint64_t frame = 0; m_headless_running && (spc.frames == 0 || frame < spc.frames); frame++)
+    {
+        on_update(spc.timestep);
+        if (spc.rate <= 0.f)
+            continue;
+
+        // Missed frames are dropped rather than caught up with a burst of updates
+        next += period;
+        const auto now = clock::now();
+        if (next > now)
+            std::this_thread::sleep_until(next);
+        else
+            next = now;
+    }
+    m_headless_running = false;
+    if (m_physics_thread)
+        m_physics_thread->stop();
+}
+
+void simulation::stop_headless()
+{
+    m_headless_running = false;
+}
+bool simulation::running_headless() const
+{
+    return m_headless_running;
+}
+
+void simulation::step_physics(const float ts)
+{
+    KIT_PERF_SCOPE("ppx::app::physics")
+    PPX_PROFILE_SCOPE("ppx::app::physics")
+    const kit::perf::clock physics_clock;
+
+    if (substeps.enabled)
+    {
+        // Neither time spent paused nor time owed before pausing is simulated
+        if (paused != m_substeps_paused)
+        {
+            substeps.clear_backlog();
+            m_substeps_paused = paused;
+        }
+        if (paused)
+        {
+            m_physics_time = physics_clock.elapsed();
+            return;
+        }
+
+        const substep_controller::plan pln = substeps.next(ts);
+        world.integrator.ts.value = pln.timestep;
+        // Telemetry is sampled once per frame, on its last substep
+        for (std::uint32_t i = 0; i < pln.substeps; i++)
+            step_world(i + 1 == pln.substeps);
+        m_physics_time = physics_clock.elapsed();
+        substeps.report(pln, m_physics_time.as<kit::perf::time::seconds, float>());
+        return;
+    }
+
+    if (sync_timestep)
+        world.integrator.ts.value = sync_speed * ts + (1.f - sync_speed) * world.integrator.ts.value;
+
+    if (!paused)
+        for (std::uint32_t i = 0; i < integrations_per_frame; i++)
+            step_world();
+    m_physics_time = physics_clock.elapsed();
+}
+
+void simulation::step_world(const bool sample_telemetry)
+{
+    const kit::perf::clock step_clock;
+    world.step();
+    if (sample_telemetry)
+        telemetry.sample(world, m_jobs, step_clock.elapsed());
+}
+
+bool simulation::sync_physics_thread()
+{
+    KIT_PERF_SCOPE("ppx::app::physics")
+    PPX_PROFILE_SCOPE("ppx::app::physics")
+    if (!m_physics_thread->running())
+        m_physics_thread->start();
+
+    m_physics_thread->paused = paused;
+    const bool consumed = m_physics_thread->consume(m_previous_snapshot, m_current_snapshot);
+    m_interpolation = m_physics_thread->interpolation(m_current_snapshot);
+    m_physics_time = m_physics_thread->step_time();
+    return consumed;
+}
+
+void simulation::play_replay()
+{
+    KIT_PERF_SCOPE("ppx::simulation::play_replay")
+    PPX_PROFILE_SCOPE("ppx::simulation::play_replay")
+    if (m_physics_thread)
+        m_physics_thread->paused = true;
+
+    if (player.frame() == replay_player::npos)
+        player.seek(0);
+    else if (!paused && player.frame() + 1 < player.frame_count())
+        player.advance();
+
+    const auto lock = lock_world();
+    player.fill(world, m_current_snapshot);
+    m_previous_snapshot.clear();
+    m_interpolation = 1.f;
+}
+
+void simulation::record_replay(const bool new_snapshot)
+{
+    KIT_PERF_SCOPE("ppx::simulation::record_replay")
+    PPX_PROFILE_SCOPE("ppx::simulation::record_replay")
+    if (m_physics_thread)
+    {
+        // Only snapshots published by the physics thread are recorded, so a paused or slow world records no duplicates
+        if (new_snapshot)
+            recorder.record(m_current_snapshot);
+        return;
+    }
+    if (paused)
+        return;
+    m_replay_snapshot.capture(world);
+    recorder.record(m_replay_snapshot);
+}
+
+void simulation::single_step()
+{
+    if (m_physics_thread)
+        m_physics_thread->request_step();
+    else
+        step_world();
+}
+
+void simulation::view(const bounds2D &area, const float pixel_size)
+{
+    m_view = area;
+    m_pixel_size = pixel_size;
+    m_has_view = true;
+}
+
+bool simulation::snapshot_driven() const
+{
+    return m_physics_thread || player.is_open();
+}
+
+bool simulation::culling_enabled() const
+{
+    return frustum_culling && m_has_view;
+}
+
+void simulation::build_shape_grid()
+{
+    if (m_shape_grid_valid)
+        return;
+    PPX_PROFILE_SCOPE("ppx::simulation::build_shape_grid")
+    m_shape_grid.clear();
+    if (snapshot_driven())
+    {
+        m_shape_grid.reserve(m_current_snapshot.colliders.size());
+        for (std::size_t i = 0; i < m_current_snapshot.colliders.size(); i++)
+            m_shape_grid.insert(i, m_current_snapshot.colliders[i].bounds);
+    }
+    else
+    {
+        m_shape_grid.reserve(world.colliders.size());
+        for (const collider2D *collider : world.colliders)
+            m_shape_grid.insert(collider->meta.index, collider_state::bounds_of(collider));
+    }
+    m_shape_grid.build();
+    m_shape_grid_valid = true;
+}
+
+void simulation::report_memory(memory_report &report) const
+{
+    report.add("Colliders", "Circles", m_circles.size(), m_circles.memory());
+    report.add("Colliders", "Polygons", m_polygons.size(), m_polygons.memory());
+    report.add("Colliders", "Polygon meshes", m_meshes.size(), m_meshes.memory());
+    report.add("Colliders", "Batched additions", m_batched_colliders.size(), vector_bytes(m_batched_colliders));
+    report.add("Culling", "Spatial grid", m_shape_grid.size(),
+               m_shape_grid.memory() + vector_bytes(m_visible_colliders));
+    report.add("Snapshots", "Interpolation", 2, m_previous_snapshot.memory() + m_current_snapshot.memory());
+    report.add("Snapshots", "Replay", 1, m_replay_snapshot.memory());
+    if (m_physics_thread)
+    {
+        const auto lock = lock_world();
+        report.add("Snapshots", "Physics thread", 3, m_physics_thread->memory());
+    }
+    report.add("Telemetry", "Samples", world_telemetry::capacity, telemetry.memory());
+
+    std::size_t sweep_bytes = 0;
+    for (std::size_t i = 0; i < sweep.size(); i++)
+        sweep_bytes += sweep[i].telemetry.memory();
+    report.add("Telemetry", "Sweep world samples", sweep.size() * world_telemetry::capacity, sweep_bytes);
+
+    report.add("Replay", "Player", player.frame_count(), player.memory());
+    report.add("Replay", "Recorder", recorder.frame_count(), recorder.memory());
+    report.add("Profiler", "Frames", frame_profiler::capacity, frame_profiler::memory());
+}
+
+bool simulation::over_memory_budget() const
+{
+    return m_over_memory_budget;
+}
+
+void simulation::check_memory_budget()
+{
+    if (memory_budget.cpu_bytes == 0 && memory_budget.gpu_bytes == 0)
+    {
+        m_over_memory_budget = false;
+        return;
+    }
+    if (m_frame % std::max(memory_check_interval, 1u) != 0)
+        return;
+
+    m_memory_report.clear();
+    report_memory(m_memory_report);
+    const bool over = m_memory_report.exceeds(memory_budget);
+    if (over && !m_over_memory_budget)
+        KIT_WARN("App memory exceeds its budget: {0} CPU and {1} GPU bytes in use", m_memory_report.cpu_bytes(),
+                 m_memory_report.gpu_bytes());
+    m_over_memory_budget = over;
+}
+
+const spatial_grid2D &simulation::shape_grid()
+{
+    build_shape_grid();
+    return m_shape_grid;
+}
+
+void simulation::update_visibility()
+{
+    PPX_PROFILE_SCOPE("ppx::simulation::update_visibility")
+    m_visible_colliders.clear();
+
+    const std::size_t colliders = m_circles.size() + m_polygons.size();
+    if (!culling_enabled())
+    {
+        m_culling.visible_colliders = colliders;
+        m_culling.culled_colliders = 0;
+        return;
+    }
+
+    build_shape_grid();
+    m_shape_grid.query(m_view, [this](const std::size_t index) { m_visible_colliders.push_back(index); });
+
+    m_culling.visible_colliders = std::min(m_visible_colliders.size(), colliders);
+    m_culling.culled_colliders = colliders - m_culling.visible_colliders;
+}
+
+void simulation::update_shapes()
+{
+    PPX_PROFILE_SCOPE("ppx::simulation::update_shapes")
+    const float greyout = sleep_greyout;
+    const std::uint64_t frame = m_frame;
+    if (!snapshot_driven())
+    {
+        for_each_visible_shape([greyout, frame](collider_repr2D &crepr) { crepr.update(greyout, frame); }, true);
+        return;
+    }
+
+    // Colliders added after the last snapshot was published keep the state they were created with
+    const auto interpolate = [this, greyout, frame](collider_repr2D &crepr) {
+        const std::size_t index = crepr.collider->meta.index;
+        const std::vector<collider_state> &previous = m_previous_snapshot.colliders;
+        const std::vector<collider_state> &current = m_current_snapshot.colliders;
+        if (index >= current.size() || current[index].collider != crepr.collider)
+            return;
+        if (index < previous.size() && previous[index].collider == crepr.collider)
+            crepr.update(collider_state::lerp(previous[index], current[index], m_interpolation), greyout, frame);
+        else
+            crepr.update(current[index], greyout, frame);
+    };
+    for_each_visible_shape(interpolate, true);
+}
+
+kit::perf::time simulation::physics_time() const
+{
+    return m_physics_time;
+}
+
+job_pool &simulation::jobs()
+{
+    return m_jobs;
+}
+
+bool simulation::threaded_physics() const
+{
+    return m_physics_thread != nullptr;
+}
+std::unique_lock<std::mutex> simulation::lock_world() const
+{
+    return m_physics_thread ? m_physics_thread->lock_world() : std::unique_lock<std::mutex>();
+}
+
+const simulation::culling_stats &simulation::culling() const
+{
+    return m_culling;
+}
+
+const repr_array<circle_repr2D> &simulation::circles() const
+{
+    return m_circles;
+}
+const repr_array<polygon_repr2D> &simulation::polygons() const
+{
+    return m_polygons;
+}
+const polygon_mesh_cache &simulation::meshes() const
+{
+    return m_meshes;
+}
+
+const collider_repr2D &simulation::shape(const collider2D *collider) const
+{
+    if (const circle_repr2D *crepr = m_circles.find(collider->meta.index))
+        return *crepr;
+    return m_polygons[collider->meta.index];
+}
+collider_repr2D &simulation::shape(const collider2D *collider)
+{
+    if (circle_repr2D *crepr = m_circles.find(collider->meta.index))
+        return *crepr;
+    return m_polygons[collider->meta.index];
+}
+
+const lynx::color &simulation::color(const collider2D *collider) const
+{
+    return shape(collider).color;
+}
+void simulation::color(const collider2D *collider, const lynx::color &color)
+{
+    shape(collider).color = color;
+}
+
+void simulation::mark_dirty(const collider2D *collider)
+{
+    shape(collider).mark_dirty();
+}
+
+collider2D *simulation::picking_state(const std::size_t index, collider_state &state) const
+{
+    const collider_repr2D *crepr = m_circles.find(index);
+    if (!crepr)
+        crepr = m_polygons.find(index);
+    if (!crepr)
+        return nullptr;
+    if (!snapshot_driven())
+    {
+        state = collider_state::from(crepr->collider);
+        return crepr->collider;
+    }
+    if (index >= m_current_snapshot.colliders.size() || m_current_snapshot.colliders[index].collider != crepr->collider)
+        return nullptr;
+    state = m_current_snapshot.colliders[index];
+    return crepr->collider;
+}
+
+collider2D *simulation::contains(const std::size_t index, const glm::vec2 &point) const
+{
+    collider_state state;
+    collider2D *collider = picking_state(index, state);
+    if (!collider || !state.bounds.contains(point))
+        return nullptr;
+
+    const glm::vec2 offset = point - state.position;
+    const float c = cosf(state.rotation), s = sinf(state.rotation);
+    const glm::vec2 local{c * offset.x + s * offset.y, -s * offset.x + c * offset.y};
+    if (const circle_repr2D *crepr = m_circles.find(index))
+        return glm::length2(local) <= crepr->radius * crepr->radius ? collider : nullptr;
+
+    // Polygons are convex, so the point is inside if it lies on the same side of every edge
+    const std::vector<glm::vec2> &vertices = m_polygons[index].mesh.mesh().vertices;
+    bool positive = false, negative = false;
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        const glm::vec2 &v1 = vertices[i];
+        const glm::vec2 &v2 = vertices[(i + 1) % vertices.size()];
+        const float cross = (v2.x - v1.x) * (local.y - v1.y) - (v2.y - v1.y) * (local.x - v1.x);
+        positive |= cross > 0.f;
+        negative |= cross < 0.f;
+    }
+    return positive && negative ? nullptr : collider;
+}
+
+collider2D *simulation::collider_at(const glm::vec2 &point)
+{
+    PPX_PROFILE_SCOPE("ppx::simulation::collider_at")
+    build_shape_grid();
+
+    // The most recently added collider is drawn on top
+    collider2D *picked = nullptr;
+    m_shape_grid.query(point, [this, &point, &picked](const std::size_t index) {
+        if (picked && index < picked->meta.index)
+            return;
+        if (collider2D *collider = contains(index, point))
+            picked = collider;
+    });
+    return picked;
+}
+
+void simulation::colliders_at(const glm::vec2 &point, std::vector<collider2D *> &colliders)
+{
+    PPX_PROFILE_SCOPE("ppx::simulation::colliders_at")
+    build_shape_grid();
+    colliders.clear();
+    m_shape_grid.query(point, [this, &point, &colliders](const std::size_t index) {
+        if (collider2D *collider = contains(index, point))
+            colliders.push_back(collider);
+    });
+}
+
+void simulation::colliders_in(const bounds2D &area, std::vector<collider2D *> &colliders, const bool fully_inside)
+{
+    PPX_PROFILE_SCOPE("ppx::simulation::colliders_in")
+    build_shape_grid();
+    colliders.clear();
+    m_shape_grid.query(area, [this, &area, &colliders, fully_inside](const std::size_t index) {
+        collider_state state;
+        collider2D *collider = picking_state(index, state);
+        if (!collider)
+            return;
+        if (!fully_inside || (area.contains(state.bounds.min) && area.contains(state.bounds.max)))
+            colliders.push_back(collider);
+    });
+}
+} // namespace ppx
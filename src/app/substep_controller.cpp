@@ -0,0 +1,75 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/app/substep_controller.hpp"
+
+namespace ppx
+{
+substep_controller::plan substep_controller::next(const float frame_time)
+{
+    KIT_ASSERT_ERROR(timestep > 0.f && max_timestep >= timestep, "Invalid substep timesteps");
+    m_frame_time = frame_time;
+    m_accumulator += frame_time;
+    if (m_accumulator > max_catch_up)
+    {
+        m_stats.dropped_time += m_accumulator - max_catch_up;
+        m_accumulator = max_catch_up;
+    }
+
+    // Until a substep has been measured, the budget is assumed to fit as many substeps as needed
+    const float cost = m_stats.substep_cost;
+    std::uint32_t affordable = max_substeps;
+    if (cost > 0.f)
+        affordable = std::clamp(static_cast<std::uint32_t>(budget / cost), 1u, max_substeps);
+
+    plan pln;
+    if (m_accumulator >= static_cast<float>(affordable) * timestep)
+    {
+        pln.substeps = affordable;
+        pln.timestep = std::min(max_timestep, m_accumulator / static_cast<float>(affordable));
+    }
+    else
+    {
+        pln.substeps = static_cast<std::uint32_t>(m_accumulator / timestep);
+        pln.timestep = timestep;
+    }
+    m_accumulator = std::max(0.f, m_accumulator - static_cast<float>(pln.substeps) * pln.timestep);
+    return pln;
+}
+
+void substep_controller::report(const plan &pln, const float physics_time)
+{
+    if (pln.substeps > 0)
+    {
+        const float cost = physics_time / static_cast<float>(pln.substeps);
+        m_stats.substep_cost =
+            m_stats.substep_cost > 0.f ? smoothing * cost + (1.f - smoothing) * m_stats.substep_cost : cost;
+    }
+    if (m_frame_time > 0.f)
+    {
+        const float factor = static_cast<float>(pln.substeps) * pln.timestep / m_frame_time;
+        m_stats.real_time_factor = smoothing * factor + (1.f - smoothing) * m_stats.real_time_factor;
+    }
+
+    m_stats.substeps = pln.substeps;
+    m_stats.timestep = pln.timestep;
+    m_stats.budget_usage = budget > 0.f ? physics_time / budget : 0.f;
+    m_stats.backlog = m_accumulator;
+}
+
+void substep_controller::reset()
+{
+    m_stats = {};
+    m_accumulator = 0.f;
+    m_frame_time = 0.f;
+}
+
+void substep_controller::clear_backlog()
+{
+    m_accumulator = 0.f;
+    m_stats.backlog = 0.f;
+}
+
+const substep_controller::stats &substep_controller::statistics() const
+{
+    return m_stats;
+}
+} // namespace ppx
@@ -0,0 +1,112 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/app/telemetry_layer.hpp"
+#include "ppx-app/app/simulation.hpp"
+
+namespace ppx
+{
+telemetry_layer::telemetry_layer(simulation &sim) : lynx::layer2D("Telemetry layer"), m_sim(sim)
+{
+}
+
+void telemetry_layer::on_render(const float ts)
+{
+    if (ImGui::BeginMainMenuBar())
+    {
+        if (ImGui::BeginMenu("View"))
+        {
+            ImGui::MenuItem("Telemetry", nullptr, &m_visible);
+            ImGui::EndMenu();
+        }
+        ImGui::EndMainMenuBar();
+    }
+    if (!m_visible)
+        return;
+
+    PPX_PROFILE_SCOPE("ppx::telemetry_layer::render")
+    if (ImGui::Begin("Telemetry", &m_visible))
+    {
+        m_sim.telemetry.read(m_samples);
+        render_controls();
+        render_plots();
+    }
+    ImGui::End();
+}
+
+void telemetry_layer::render_controls()
+{
+    world_telemetry &telemetry = m_sim.telemetry;
+    bool enabled = telemetry.enabled;
+    if (ImGui::Checkbox("Enabled", &enabled))
+        telemetry.enabled = enabled;
+    ImGui::SameLine();
+    int interval = static_cast<int>(telemetry.interval.load());
+    if (ImGui::SliderInt("Interval", &interval, 1, 64))
+        telemetry.interval = static_cast<std::uint32_t>(interval);
+
+    ImGui::InputText("File", m_path.data(), m_path.size());
+    ImGui::SameLine();
+    if (ImGui::Button("Export") && !telemetry.write_csv(m_path.data()))
+        KIT_ERROR("Failed to export telemetry to '{0}'", m_path.data());
+
+    ImGui::Text("Samples: %zu retained, %llu total", m_samples.size(),
+                static_cast<unsigned long long>(telemetry.total_samples()));
+    if (m_samples.empty())
+        return;
+    const telemetry_sample &last = m_samples.back();
+    ImGui::Text("Bodies: %u (%u asleep), colliders: %u, contacts: %u, islands: %u", last.bodies, last.sleeping_bodies,
+                last.colliders, last.contacts, last.islands);
+    ImGui::Text("Step time: %.3f ms, kinetic energy: %.3f", last.step_time, last.kinetic_energy);
+}
+
+template <typename F> void telemetry_layer::plot(const char *label, F &&value)
+{
+#ifdef LYNX_ENABLE_IMPLOT
+    for (std::size_t i = 0; i < m_samples.size(); i++)
+        m_values[i] = static_cast<double>(value(m_samples[i]));
+    ImPlot::PlotLine(label, m_steps.data(), m_values.data(), static_cast<int>(m_samples.size()));
+#endif
+}
+
+void telemetry_layer::render_plots()
+{
+#ifdef LYNX_ENABLE_IMPLOT
+    if (m_samples.empty())
+        return;
+    m_steps.resize(m_samples.size());
+    m_values.resize(m_samples.size());
+    for (std::size_t i = 0; i < m_samples.size(); i++)
+        m_steps[i] = static_cast<double>(m_samples[i].step);
+
+    const ImVec2 size{-1.f, 160.f};
+    if (ImPlot::BeginPlot("Counts", size))
+    {
+        ImPlot::SetupAxes("Step", nullptr, ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        plot("Bodies", [](const telemetry_sample &s) { return s.bodies; });
+        plot("Colliders", [](const telemetry_sample &s) { return s.colliders; });
+        plot("Contacts", [](const telemetry_sample &s) { return s.contacts; });
+        plot("Islands", [](const telemetry_sample &s) { return s.islands; });
+        ImPlot::EndPlot();
+    }
+    if (ImPlot::BeginPlot("Sleeping fraction", size))
+    {
+        ImPlot::SetupAxes("Step", nullptr, ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        plot("Sleeping", [](const telemetry_sample &s) {
+            return s.bodies == 0 ? 0.f : static_cast<float>(s.sleeping_bodies) / static_cast<float>(s.bodies);
+        });
+        ImPlot::EndPlot();
+    }
+    if (ImPlot::BeginPlot("Step time", size))
+    {
+        ImPlot::SetupAxes("Step", "Time (ms)", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        plot("Step", [](const telemetry_sample &s) { return s.step_time; });
+        ImPlot::EndPlot();
+    }
+    if (ImPlot::BeginPlot("Energy", size))
+    {
+        ImPlot::SetupAxes("Step", nullptr, ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        plot("Kinetic", [](const telemetry_sample &s) { return s.kinetic_energy; });
+        ImPlot::EndPlot();
+    }
+#endif
+}
+} // namespace ppx
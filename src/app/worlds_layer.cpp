@@ -0,0 +1,157 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/app/worlds_layer.hpp"
+#include "ppx-app/app/simulation.hpp"
+
+namespace ppx
+{
+// Fits the bounding boxes of a world's colliders into a screen rectangle, keeping the aspect ratio and pointing y up
+static void draw_world(const world2D &world, const ImVec2 &min, const ImVec2 &size, const std::size_t budget)
+{
+    ImDrawList *draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(min, ImVec2(min.x + size.x, min.y + size.y), IM_COL32(25, 25, 30, 255));
+    if (world.colliders.size() == 0)
+        return;
+
+    const std::size_t stride = std::max<std::size_t>(1, world.colliders.size() / std::max<std::size_t>(budget, 1));
+    bounds2D extent = collider_state::bounds_of(*world.colliders.begin());
+    std::size_t index = 0;
+    for (const collider2D *collider : world.colliders)
+        if (index++ % stride == 0)
+        {
+            const bounds2D bounds = collider_state::bounds_of(collider);
+            extent.enclose(bounds.min);
+            extent.enclose(bounds.max);
+        }
+
+    const glm::vec2 dim = glm::max(extent.dimension(), glm::vec2(1e-3f));
+    const float scale = 0.95f * std::min(size.x / dim.x, size.y / dim.y);
+    const glm::vec2 center = extent.center();
+    const auto to_screen = [&min, &size, scale, &center](const glm::vec2 &point) {
+        return ImVec2(min.x + 0.5f * size.x + scale * (point.x - center.x),
+                      min.y + 0.5f * size.y - scale * (point.y - center.y));
+    };
+
+    draw_list->PushClipRect(min, ImVec2(min.x + size.x, min.y + size.y), true);
+    index = 0;
+    for (const collider2D *collider : world.colliders)
+    {
+        if (index++ % stride != 0)
+            continue;
+        const bounds2D bounds = collider_state::bounds_of(collider);
+        const ImU32 color = collider->body()->asleep() ? IM_COL32(90, 100, 110, 255) : IM_COL32(123, 143, 161, 255);
+        if (collider->shape_if<circle>())
+            draw_list->AddCircle(to_screen(bounds.center()), 0.5f * scale * bounds.dimension().x, color);
+        else
+            draw_list->AddRect(to_screen({bounds.min.x, bounds.max.y}), to_screen({bounds.max.x, bounds.min.y}), color);
+    }
+    draw_list->PopClipRect();
+}
+
+worlds_layer::worlds_layer(simulation &sim) : lynx::layer2D("Worlds layer"), m_sim(sim)
+{
+}
+
+void worlds_layer::on_render(const float ts)
+{
+    if (ImGui::BeginMainMenuBar())
+    {
+        if (ImGui::BeginMenu("View"))
+        {
+            ImGui::MenuItem("Worlds", nullptr, &m_visible);
+            ImGui::EndMenu();
+        }
+        ImGui::EndMainMenuBar();
+    }
+    if (!m_visible)
+        return;
+
+    PPX_PROFILE_SCOPE("ppx::worlds_layer::render")
+    if (ImGui::Begin("Worlds", &m_visible))
+    {
+        render_controls();
+        if (!m_sim.sweep.empty())
+        {
+            m_selected = std::min(m_selected, m_sim.sweep.size() - 1);
+            render_thumbnails();
+            render_selected();
+        }
+    }
+    ImGui::End();
+}
+
+void worlds_layer::render_controls()
+{
+    world_runner &sweep = m_sim.sweep;
+    if (ImGui::Button(sweep.paused ? "Run" : "Pause"))
+        sweep.paused = !sweep.paused;
+    ImGui::SameLine();
+    int steps = static_cast<int>(sweep.steps_per_update);
+    if (ImGui::SliderInt("Steps per update", &steps, 1, 64))
+        sweep.steps_per_update = static_cast<std::uint32_t>(steps);
+
+    const world_runner::stats &stats = sweep.statistics();
+    ImGui::Text("Worlds: %zu on %zu threads", sweep.size(), m_sim.jobs().thread_count() + 1);
+    ImGui::Text("Last update: %.2f ms, %.0f world steps per second",
+                1000.f * stats.wall_time.as<kit::perf::time::seconds, float>(), stats.steps_per_second);
+
+    if (ImGui::Button("Copy main world"))
+    {
+        const auto lock = m_sim.lock_world();
+        sweep.add(m_sim.world, "World " + std::to_string(sweep.size()));
+    }
+    ImGui::InputText("Snapshot", m_snapshot_path.data(), m_snapshot_path.size());
+    ImGui::SameLine();
+    if (ImGui::Button("Load") && !sweep.load(m_snapshot_path.data(), m_snapshot_path.data()))
+        KIT_ERROR("Failed to load a sweep world from '{0}'", m_snapshot_path.data());
+
+    ImGui::InputText("File", m_path.data(), m_path.size());
+    ImGui::SameLine();
+    if (ImGui::Button("Export") && !sweep.write_csv(m_path.data()))
+        KIT_ERROR("Failed to export sweep results to '{0}'", m_path.data());
+}
+
+void worlds_layer::render_thumbnails()
+{
+    if (!ImGui::CollapsingHeader("Thumbnails", ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+    const float spacing = ImGui::GetStyle().ItemSpacing.x;
+    const std::size_t columns = std::max<std::size_t>(
+        1, static_cast<std::size_t>((ImGui::GetContentRegionAvail().x + spacing) / (thumbnail_size + spacing)));
+    const ImVec2 size{thumbnail_size, thumbnail_size};
+    for (std::size_t i = 0; i < m_sim.sweep.size(); i++)
+    {
+        const world_runner::instance &inst = m_sim.sweep[i];
+        if (i % columns != 0)
+            ImGui::SameLine();
+
+        ImGui::PushID(static_cast<int>(i));
+        const ImVec2 min = ImGui::GetCursorScreenPos();
+        if (ImGui::InvisibleButton("World", size))
+            m_selected = i;
+        draw_world(inst.world, min, size, thumbnail_budget);
+        if (i == m_selected)
+            ImGui::GetWindowDrawList()->AddRect(min, ImVec2(min.x + size.x, min.y + size.y),
+                                                IM_COL32(207, 185, 151, 255), 0.f, 0, 2.f);
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("%s: %llu steps", inst.label.c_str(), static_cast<unsigned long long>(inst.steps));
+        ImGui::PopID();
+    }
+}
+
+void worlds_layer::render_selected()
+{
+    const world_runner::instance &inst = m_sim.sweep[m_selected];
+    if (!ImGui::CollapsingHeader(inst.label.c_str(), ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+    ImGui::Text("Steps: %llu, simulated time: %.2f s, last step: %.3f ms", static_cast<unsigned long long>(inst.steps),
+                inst.simulated_time, 1000.f * inst.step_time.as<kit::perf::time::seconds, float>());
+    ImGui::TextDisabled("Every collider, as bounding box outlines drawn with ImGui rather than the app's renderer");
+    const float width = ImGui::GetContentRegionAvail().x;
+    const ImVec2 size{width, 0.6f * width};
+    const ImVec2 min = ImGui::GetCursorScreenPos();
+    ImGui::Dummy(size);
+    draw_world(inst.world, min, size, inst.world.colliders.size());
+}
+} // namespace ppx
@@ -0,0 +1,83 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/drawables/batches/capsule_batch.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+
+namespace ppx
+{
+capsule_batch2D::capsule_batch2D(const std::uint32_t cap_segments)
+{
+    KIT_ASSERT_ERROR(cap_segments >= 1, "A capsule cap must have at least 1 segment");
+
+    // Counter-clockwise, in radius units along the segment and its normal
+    m_outline.reserve(2 * (cap_segments + 1));
+    for (std::uint32_t i = 0; i <= cap_segments; i++)
+    {
+        const float angle = -0.5f * glm::pi<float>() + glm::pi<float>() * i / cap_segments;
+        m_outline.push_back({true, {cosf(angle), sinf(angle)}});
+    }
+    for (std::uint32_t i = 0; i <= cap_segments; i++)
+    {
+        const float angle = 0.5f * glm::pi<float>() + glm::pi<float>() * i / cap_segments;
+        m_outline.push_back({false, {cosf(angle), sinf(angle)}});
+    }
+}
+
+void capsule_batch2D::clear()
+{
+    m_vertices.clear();
+    m_indices.clear();
+    m_size = 0;
+}
+
+void capsule_batch2D::reserve(const std::size_t capsules)
+{
+    m_vertices.reserve(capsules * m_outline.size());
+    m_indices.reserve(capsules * 3 * (m_outline.size() - 2));
+}
+
+void capsule_batch2D::push(const glm::vec2 &p1, const glm::vec2 &p2, const float radius, const lynx::color &color)
+{
+    const glm::vec2 segment = p2 - p1;
+    const float length = glm::length(segment);
+    const glm::vec2 dir = length > 0.f ? radius * segment / length : glm::vec2(radius, 0.f);
+    const glm::vec2 normal{-dir.y, dir.x};
+
+    const auto base = static_cast<std::uint32_t>(m_vertices.size());
+    for (const outline_vertex &ov : m_outline)
+        m_vertices.push_back({(ov.second_endpoint ? p2 : p1) + ov.offset.x * dir + ov.offset.y * normal, color});
+
+    // The outline is convex, so a fan from its first vertex covers it
+    const auto count = static_cast<std::uint32_t>(m_outline.size());
+    for (std::uint32_t i = 1; i < count - 1; i++)
+    {
+        m_indices.push_back(base);
+        m_indices.push_back(base + i);
+        m_indices.push_back(base + i + 1);
+    }
+    m_size++;
+}
+
+void capsule_batch2D::draw(lynx::window2D &window) const
+{
+    if (!m_indices.empty())
+        window.draw(m_vertices, m_indices, lynx::topology::TRIANGLE_LIST);
+}
+
+std::size_t capsule_batch2D::size() const
+{
+    return m_size;
+}
+bool capsule_batch2D::empty() const
+{
+    return m_size == 0;
+}
+
+std::size_t capsule_batch2D::memory() const
+{
+    return vector_bytes(m_outline) + vector_bytes(m_vertices) + vector_bytes(m_indices);
+}
+std::size_t capsule_batch2D::uploaded_bytes() const
+{
+    return m_vertices.size() * sizeof(lynx::vertex2D) + m_indices.size() * sizeof(std::uint32_t);
+}
+} // namespace ppx
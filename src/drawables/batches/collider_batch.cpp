@@ -0,0 +1,229 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/drawables/batches/collider_batch.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+
+namespace ppx
+{
+collider_batch2D::collider_batch2D(const std::uint32_t circle_segments) : m_circle_segments(circle_segments)
+{
+    KIT_ASSERT_ERROR(circle_segments >= 3, "A circle must have at least 3 segments");
+    for (std::size_t l = 0; l < circle_levels; l++)
+    {
+        circle_level &level = m_levels[l];
+        level.segments = std::max<std::uint32_t>(3, circle_segments >> l);
+        level.unit_circle.reserve(level.segments);
+        for (std::uint32_t i = 0; i < level.segments; i++)
+        {
+            const float angle = 2.f * glm::pi<float>() * i / level.segments;
+            level.unit_circle.emplace_back(cosf(angle), sinf(angle));
+        }
+    }
+}
+
+void collider_batch2D::clear()
+{
+    for (circle_level &level : m_levels)
+        level.instances.clear();
+    m_polygon_vertices.clear();
+    m_polygon_indices.clear();
+    m_points.clear();
+    m_polygon_count = 0;
+}
+
+void collider_batch2D::reserve(const std::size_t circles, const std::size_t polygon_vertices)
+{
+    m_levels[0].instances.reserve(circles);
+    m_polygon_vertices.reserve(polygon_vertices);
+    m_polygon_indices.reserve(3 * polygon_vertices);
+}
+
+void collider_batch2D::pixel_size(const float pixel_size)
+{
+    m_pixel_size = pixel_size;
+}
+
+bool collider_batch2D::push_point(const glm::vec2 &position, const float radius, const lynx::color &color)
+{
+    if (!lod.enabled || m_pixel_size <= 0.f || radius > lod.subpixel_radius * m_pixel_size)
+        return false;
+    if (!lod.skip_subpixel)
+        m_points.push_back({position, color});
+    return true;
+}
+
+void collider_batch2D::push_circle(const glm::mat3 &transform, const float radius, const lynx::color &color)
+{
+    const glm::vec2 position{transform[2]};
+    const glm::vec2 axis = radius * glm::vec2(transform[0]);
+    const float world_radius = glm::length(axis);
+    if (push_point(position, world_radius, color))
+        return;
+
+    std::size_t l = 0;
+    if (lod.enabled && m_pixel_size > 0.f)
+    {
+        float threshold = lod.full_detail_radius * m_pixel_size;
+        while (l + 1 < circle_levels && world_radius < threshold &&
+               m_levels[l + 1].segments >= lod.min_circle_segments)
+        {
+            threshold *= 0.25f;
+            l++;
+        }
+    }
+    m_levels[l].instances.push_back({position, axis, color});
+}
+
+void collider_batch2D::close_polygon(const std::uint32_t base)
+{
+    const auto end = static_cast<std::uint32_t>(m_polygon_vertices.size());
+    KIT_ASSERT_ERROR(end - base >= 3, "A polygon must have at least 3 vertices");
+
+    if (lod.enabled && m_pixel_size > 0.f)
+    {
+        glm::vec2 min = m_polygon_vertices[base].position, max = min;
+        for (std::uint32_t i = base + 1; i < end; i++)
+        {
+            min = glm::min(min, m_polygon_vertices[i].position);
+            max = glm::max(max, m_polygon_vertices[i].position);
+        }
+        const glm::vec2 half_extent = 0.5f * (max - min);
+        const lynx::color color = m_polygon_vertices[base].color;
+        if (push_point(0.5f * (min + max), std::max(half_extent.x, half_extent.y), color))
+        {
+            m_polygon_vertices.resize(base);
+            return;
+        }
+    }
+
+    triangulate(base);
+}
+
+void collider_batch2D::push_polygon(const glm::mat3 &transform, const polygon_mesh &mesh, const lynx::color &color)
+{
+    KIT_ASSERT_ERROR(mesh.vertices.size() >= 3, "A polygon must have at least 3 vertices");
+    const glm::vec2 position{transform[2]};
+    const float scale = std::max(glm::length(glm::vec2(transform[0])), glm::length(glm::vec2(transform[1])));
+    if (push_point(position, scale * mesh.radius, color))
+        return;
+
+    const auto base = static_cast<std::uint32_t>(m_polygon_vertices.size());
+    for (const glm::vec2 &vertex : mesh.vertices)
+        m_polygon_vertices.push_back({glm::vec2(transform * glm::vec3(vertex, 1.f)), color});
+    triangulate(base);
+}
+
+void collider_batch2D::triangulate(const std::uint32_t base)
+{
+    const auto end = static_cast<std::uint32_t>(m_polygon_vertices.size());
+    for (std::uint32_t i = base + 1; i < end - 1; i++)
+    {
+        m_polygon_indices.push_back(base);
+        m_polygon_indices.push_back(i);
+        m_polygon_indices.push_back(i + 1);
+    }
+    m_polygon_count++;
+}
+
+void collider_batch2D::expand_circles(const circle_level &level) const
+{
+    // Indices only depend on the circle count, so they persist between frames
+    const std::size_t stride = level.segments + 1;
+    const std::size_t built = level.indices.size() / (3 * level.segments);
+    if (built >= level.instances.size())
+        level.indices.resize(3 * level.segments * level.instances.size());
+    else
+    {
+        level.indices.reserve(3 * level.segments * level.instances.size());
+        for (std::size_t i = built; i < level.instances.size(); i++)
+        {
+            const auto center = static_cast<std::uint32_t>(i * stride);
+            for (std::uint32_t j = 0; j < level.segments; j++)
+            {
+                level.indices.push_back(center);
+                level.indices.push_back(center + 1 + j);
+                level.indices.push_back(center + 1 + (j + 1) % level.segments);
+            }
+        }
+    }
+
+    level.vertices.resize(level.instances.size() * stride);
+    for (std::size_t i = 0; i < level.instances.size(); i++)
+    {
+        const circle_instance &circle = level.instances[i];
+        const glm::vec2 normal{-circle.axis.y, circle.axis.x};
+
+        lynx::vertex2D *vertices = level.vertices.data() + i * stride;
+        vertices[0] = {circle.position, circle.color};
+        for (std::uint32_t j = 0; j < level.segments; j++)
+        {
+            const glm::vec2 &unit = level.unit_circle[j];
+            vertices[j + 1] = {circle.position + unit.x * circle.axis + unit.y * normal, circle.color};
+        }
+        if (draw_markers)
+        {
+            m_marker_vertices.push_back({circle.position, marker_color});
+            m_marker_vertices.push_back({circle.position + circle.axis, marker_color});
+        }
+    }
+}
+
+void collider_batch2D::draw(lynx::window2D &window) const
+{
+    if (!m_polygon_indices.empty())
+        window.draw(m_polygon_vertices, m_polygon_indices, lynx::topology::TRIANGLE_LIST);
+
+    m_marker_vertices.clear();
+    for (const circle_level &level : m_levels)
+        if (!level.instances.empty())
+        {
+            expand_circles(level);
+            window.draw(level.vertices, level.indices, lynx::topology::TRIANGLE_LIST);
+        }
+
+    if (draw_markers && !m_marker_vertices.empty())
+        window.draw(m_marker_vertices, lynx::topology::LINE_LIST);
+    if (!m_points.empty())
+        window.draw(m_points, lynx::topology::POINT_LIST);
+}
+
+std::uint32_t collider_batch2D::circle_segments() const
+{
+    return m_circle_segments;
+}
+std::size_t collider_batch2D::circle_count() const
+{
+    std::size_t count = 0;
+    for (const circle_level &level : m_levels)
+        count += level.instances.size();
+    return count;
+}
+std::size_t collider_batch2D::polygon_count() const
+{
+    return m_polygon_count;
+}
+std::size_t collider_batch2D::point_count() const
+{
+    return m_points.size();
+}
+
+std::size_t collider_batch2D::memory() const
+{
+    std::size_t bytes = vector_bytes(m_polygon_vertices) + vector_bytes(m_polygon_indices) + vector_bytes(m_points) +
+                        vector_bytes(m_marker_vertices);
+    for (const circle_level &level : m_levels)
+        bytes += vector_bytes(level.unit_circle) + vector_bytes(level.instances) + vector_bytes(level.vertices) +
+                 vector_bytes(level.indices);
+    return bytes;
+}
+std::size_t collider_batch2D::uploaded_bytes() const
+{
+    std::size_t bytes = m_polygon_vertices.size() * sizeof(lynx::vertex2D) +
+                        m_polygon_indices.size() * sizeof(std::uint32_t) + m_points.size() * sizeof(lynx::vertex2D);
+    if (draw_markers)
+        bytes += m_marker_vertices.size() * sizeof(lynx::vertex2D);
+    for (const circle_level &level : m_levels)
+        bytes += level.vertices.size() * sizeof(lynx::vertex2D) + level.indices.size() * sizeof(std::uint32_t);
+    return bytes;
+}
+
+} // namespace ppx
@@ -0,0 +1,259 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/drawables/batches/debug_overlay.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+#include "ppx/collision/broad/quad_tree_broad.hpp"
+
+#include <numeric>
+
+namespace ppx
+{
+static lynx::color group_color(const std::size_t root)
+{
+    // Golden ratio hue steps keep the colors of consecutive roots far apart
+    const float hue = glm::fract(static_cast<float>(root) * 0.618034f);
+    const glm::vec3 rgb =
+        glm::clamp(glm::abs(glm::mod(6.f * hue + glm::vec3(0.f, 4.f, 2.f), 6.f) - 3.f) - 1.f, 0.f, 1.f);
+    return lynx::color{glm::vec4(0.3f + 0.7f * rgb, 1.f)};
+}
+
+bool debug_overlay2D::enabled() const
+{
+    return show_broad_phase || show_contacts || show_islands || show_grid || show_bounds || show_overlaps ||
+           show_groups;
+}
+
+void debug_overlay2D::build(const world2D &world, const spatial_grid2D &grid, const bounds2D &view,
+                            const float pixel_size)
+{
+    m_lines.clear();
+    m_stats = {};
+    if (show_broad_phase)
+        build_broad_phase(world, view);
+    if (show_islands)
+        build_islands(world, grid, view);
+    if (show_contacts)
+        build_contacts(world, view, pixel_size);
+    if (show_grid)
+        build_grid(grid, view);
+    if (!show_bounds && !show_overlaps && !show_groups)
+        return;
+
+    m_visible.clear();
+    grid.query_bounds(view,
+                      [this](const std::size_t id, const bounds2D &bounds) { m_visible.emplace_back(id, bounds); });
+    m_stats.bounds = m_visible.size();
+    if (show_overlaps || show_groups)
+        build_overlaps(grid, pixel_size);
+
+    if (!show_bounds && !show_groups)
+        return;
+    for (const auto &[id, bounds] : m_visible)
+    {
+        if (!show_groups)
+        {
+            push_box(bounds, bounds_color);
+            continue;
+        }
+        const std::size_t r = root(id);
+        if (m_sizes[r] > 1)
+            push_box(bounds, group_color(r));
+        else if (show_bounds)
+            push_box(bounds, bounds_color);
+    }
+}
+
+void debug_overlay2D::build_broad_phase(const world2D &world, const bounds2D &view)
+{
+    // Only the quad tree broad phase partitions space. Other broad phases have no cells to show
+    const auto *broad = world.collisions.broad<quad_tree_broad2D>();
+    if (!broad)
+        return;
+    broad->quad_tree().traverse([this, &view](const auto &node) {
+        const bounds2D cell{node.aabb.min, node.aabb.max};
+        if (!cell.intersects(view))
+            return false;
+        push_box(cell, broad_phase_color);
+        m_stats.broad_phase_cells++;
+        return true;
+    });
+}
+
+void debug_overlay2D::build_contacts(const world2D &world, const bounds2D &view, const float pixel_size)
+{
+    const float size = point_size * pixel_size;
+    for (const collision2D &collision : world.collisions)
+    {
+        if (!collision.collided)
+            continue;
+        for (std::size_t i = 0; i < collision.manifold.size(); i++)
+        {
+            const glm::vec2 &point = collision.manifold[i];
+            if (!view.contains(point))
+                continue;
+            push_point(point, size, contact_color);
+            m_stats.contacts++;
+        }
+    }
+}
+
+void debug_overlay2D::build_islands(const world2D &world, const spatial_grid2D &grid, const bounds2D &view)
+{
+    static constexpr std::uint32_t no_island = UINT32_MAX;
+    m_islands.assign(world.bodies.size(), no_island);
+    m_island_bounds.clear();
+    m_island_state.clear();
+    for (const island2D *island : world.islands)
+    {
+        const auto index = static_cast<std::uint32_t>(m_island_state.size());
+        for (const body2D *body : island->bodies())
+            m_islands[body->meta.index] = index;
+        // 0 while no collider of the island is in view, then 1 if awake and 2 if asleep
+        m_island_state.push_back(0);
+        m_island_bounds.emplace_back();
+    }
+
+    // Island bounds enclose the bounding boxes of their colliders in view. The grid may lag the world by a step
+    grid.query_bounds(view, [this, &world](const std::size_t id, const bounds2D &bounds) {
+        if (id >= world.colliders.size())
+            return;
+        const collider2D *collider = world.colliders[id];
+        const std::uint32_t island = m_islands[collider->body()->meta.index];
+        if (island == no_island)
+            return;
+        if (m_island_state[island] == 0)
+        {
+            m_island_bounds[island] = bounds;
+            m_island_state[island] = collider->body()->asleep() ? 2 : 1;
+        }
+        else
+        {
+            m_island_bounds[island].enclose(bounds.min);
+            m_island_bounds[island].enclose(bounds.max);
+        }
+    });
+
+    for (std::size_t i = 0; i < m_island_state.size(); i++)
+        if (m_island_state[i] != 0)
+        {
+            const lynx::color color = group_color(i);
+            push_box(m_island_bounds[i], m_island_state[i] == 2 ? lynx::color{0.4f * color.rgba} : color);
+            m_stats.islands++;
+        }
+}
+
+void debug_overlay2D::build_grid(const spatial_grid2D &grid, const bounds2D &view)
+{
+    grid.for_each_cell(view, [this](const bounds2D &, const std::uint32_t count) {
+        m_stats.max_occupancy = std::max(m_stats.max_occupancy, count);
+    });
+    if (m_stats.max_occupancy == 0)
+        return;
+
+    const float max_occupancy = static_cast<float>(m_stats.max_occupancy);
+    grid.for_each_cell(view, [this, max_occupancy](const bounds2D &cell, const std::uint32_t count) {
+        if (count == 0)
+            return;
+        const float t = static_cast<float>(count) / max_occupancy;
+        push_box(cell, lynx::color{glm::mix(grid_color.rgba, crowded_cell_color.rgba, t)});
+        m_stats.cells++;
+    });
+}
+
+void debug_overlay2D::build_overlaps(const spatial_grid2D &grid, const float pixel_size)
+{
+    if (show_groups)
+    {
+        std::size_t max_id = 0;
+        for (const auto &[id, bounds] : m_visible)
+            max_id = std::max(max_id, id);
+        m_parents.resize(max_id + 1);
+        std::iota(m_parents.begin(), m_parents.end(), std::size_t{0});
+        m_sizes.assign(max_id + 1, 1);
+    }
+
+    const float size = point_size * pixel_size;
+    for (const auto &[id, bounds] : m_visible)
+    {
+        if (m_stats.truncated)
+            break;
+        grid.query_bounds(bounds, [this, id, &bounds, size](const std::size_t other, const bounds2D &obounds) {
+            // Each pair is reported from its lowest id
+            if (other <= id || m_stats.truncated)
+                return;
+            if (++m_stats.overlaps >= max_overlaps)
+                m_stats.truncated = true;
+            if (show_overlaps)
+            {
+                const bounds2D overlap{glm::max(bounds.min, obounds.min), glm::min(bounds.max, obounds.max)};
+                push_point(overlap.center(), size, overlap_color);
+            }
+            // Neighbours past the highest visible id are left ungrouped, which can only split groups crossing the view
+            if (show_groups && other < m_parents.size())
+                unite(id, other);
+        });
+    }
+
+    if (show_groups)
+        for (const auto &[id, bounds] : m_visible)
+            if (root(id) == id && m_sizes[id] > 1)
+                m_stats.groups++;
+}
+
+void debug_overlay2D::push_box(const bounds2D &bounds, const lynx::color &color)
+{
+    const glm::vec2 p1{bounds.max.x, bounds.min.y};
+    const glm::vec2 p2{bounds.min.x, bounds.max.y};
+    m_lines.push(bounds.min, p1, color);
+    m_lines.push(p1, bounds.max, color);
+    m_lines.push(bounds.max, p2, color);
+    m_lines.push(p2, bounds.min, color);
+}
+
+void debug_overlay2D::push_point(const glm::vec2 &point, const float size, const lynx::color &color)
+{
+    m_lines.push(point - size, point + size, color);
+    m_lines.push(point + glm::vec2(-size, size), point + glm::vec2(size, -size), color);
+}
+
+std::size_t debug_overlay2D::root(std::size_t id)
+{
+    while (m_parents[id] != id)
+    {
+        m_parents[id] = m_parents[m_parents[id]];
+        id = m_parents[id];
+    }
+    return id;
+}
+
+void debug_overlay2D::unite(const std::size_t id1, const std::size_t id2)
+{
+    std::size_t r1 = root(id1);
+    std::size_t r2 = root(id2);
+    if (r1 == r2)
+        return;
+    if (m_sizes[r1] < m_sizes[r2])
+        std::swap(r1, r2);
+    m_parents[r2] = r1;
+    m_sizes[r1] += m_sizes[r2];
+}
+
+void debug_overlay2D::draw(lynx::window2D &window) const
+{
+    m_lines.draw(window);
+}
+
+const debug_overlay2D::stats &debug_overlay2D::statistics() const
+{
+    return m_stats;
+}
+
+std::size_t debug_overlay2D::memory() const
+{
+    return m_lines.memory() + vector_bytes(m_visible) + vector_bytes(m_parents) + vector_bytes(m_sizes) +
+           vector_bytes(m_islands) + vector_bytes(m_island_bounds) + vector_bytes(m_island_state);
+}
+std::size_t debug_overlay2D::uploaded_bytes() const
+{
+    return m_lines.uploaded_bytes();
+}
+} // namespace ppx
@@ -0,0 +1,46 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/drawables/batches/line_batch.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+
+namespace ppx
+{
+void line_batch2D::clear()
+{
+    m_vertices.clear();
+}
+
+void line_batch2D::reserve(const std::size_t lines)
+{
+    m_vertices.reserve(2 * lines);
+}
+
+void line_batch2D::push(const glm::vec2 &p1, const glm::vec2 &p2, const lynx::color &color)
+{
+    m_vertices.push_back({p1, color});
+    m_vertices.push_back({p2, color});
+}
+
+void line_batch2D::draw(lynx::window2D &window) const
+{
+    if (!m_vertices.empty())
+        window.draw(m_vertices, lynx::topology::LINE_LIST);
+}
+
+std::size_t line_batch2D::size() const
+{
+    return m_vertices.size() / 2;
+}
+bool line_batch2D::empty() const
+{
+    return m_vertices.empty();
+}
+
+std::size_t line_batch2D::memory() const
+{
+    return vector_bytes(m_vertices);
+}
+std::size_t line_batch2D::uploaded_bytes() const
+{
+    return m_vertices.size() * sizeof(lynx::vertex2D);
+}
+} // namespace ppx
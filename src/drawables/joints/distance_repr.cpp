@@ -11,18 +11,33 @@ distance_repr2D::distance_repr2D(const distance_joint2D *dj, const float sleep_g
 
 void distance_repr2D::update(const float sleep_greyout)
 {
-    m_line.p1(m_dj->ganchor1());
-    m_line.p2(m_dj->ganchor2());
+    update(state(), sleep_greyout);
+}
+void distance_repr2D::update(const joint_state &state, const float sleep_greyout)
+{
+    m_line.points(state.anchor1, state.anchor2);
+
+    // Same as a compress-relax-stretch gradient, without building one for every joint and frame
+    const float stress = std::clamp(state.value * 6.f, -1.f, 1.f);
+    const glm::vec4 rgba = stress < 0.f ? glm::mix(relax.rgba, compress.rgba, -stress)
+                                        : glm::mix(relax.rgba, stretch.rgba, stress);
+    const lynx::color color{rgba};
+    m_line.color(state.asleep ? sleep_greyout * color : color);
+}
 
-    const float stress = m_dj->constraint_position() * 6.f;
-    const lynx::gradient<3> grad{compress, relax, stretch};
-    const lynx::color color = grad.evaluate(std::clamp(0.5f * (stress + 1.f), 0.f, 1.f));
-    m_line.color(m_dj->asleep() ? sleep_greyout * color : color);
+joint_state distance_repr2D::state() const
+{
+    return {m_dj, m_dj->ganchor1(), m_dj->ganchor2(), m_dj->constraint_position(), m_dj->asleep()};
+}
+
+void distance_repr2D::draw(joint_batches2D &batches) const
+{
+    m_line.draw(batches.capsules);
 }
 
-void distance_repr2D::draw(lynx::window2D &window) const
+const distance_joint2D *distance_repr2D::joint() const
 {
-    window.draw(m_line);
+    return m_dj;
 }
 
 } // namespace ppx
\ No newline at end of file
@@ -4,22 +4,35 @@
 namespace ppx
 {
 prismatic_repr2D::prismatic_repr2D(const prismatic_joint2D *pj, const lynx::color &color, const float sleep_greyout)
-    : m_pj(pj), m_line(pj->ganchor1(), pj->ganchor2(), color), m_color(color)
+    : m_pj(pj), m_anchor1(pj->ganchor1()), m_anchor2(pj->ganchor2()), m_color(color), m_current_color(color)
 {
     update(sleep_greyout);
 }
 
 void prismatic_repr2D::update(const float sleep_greyout)
 {
-    m_line.p1(m_pj->ganchor1());
-    m_line.p2(m_pj->ganchor2());
+    update(state(), sleep_greyout);
+}
+void prismatic_repr2D::update(const joint_state &state, const float sleep_greyout)
+{
+    m_anchor1 = state.anchor1;
+    m_anchor2 = state.anchor2;
+    m_current_color = state.asleep ? sleep_greyout * m_color : m_color;
+}
 
-    m_line.color(m_pj->asleep() ? sleep_greyout * m_color : m_color);
+joint_state prismatic_repr2D::state() const
+{
+    return {m_pj, m_pj->ganchor1(), m_pj->ganchor2(), 0.f, m_pj->asleep()};
+}
+
+void prismatic_repr2D::draw(joint_batches2D &batches) const
+{
+    batches.lines.push(m_anchor1, m_anchor2, m_current_color);
 }
 
-void prismatic_repr2D::draw(lynx::window2D &window) const
+const prismatic_joint2D *prismatic_repr2D::joint() const
 {
-    window.draw(m_line);
+    return m_pj;
 }
 
 } // namespace ppx
\ No newline at end of file
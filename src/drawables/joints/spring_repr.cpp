@@ -4,22 +4,75 @@
 namespace ppx
 {
 spring_repr2D::spring_repr2D(const spring_joint2D *sj, const lynx::color &color, const float sleep_greyout)
-    : m_sj(sj), m_line(sj->ganchor1(), sj->ganchor2(), color), m_color(color)
+    : m_sj(sj), m_line(sj->ganchor1(), sj->ganchor2(), color), m_color(color), m_anchor1(sj->ganchor1()),
+      m_anchor2(sj->ganchor2())
 {
     update(sleep_greyout);
 }
 
 void spring_repr2D::update(const float sleep_greyout)
 {
-    m_line.p1(m_sj->ganchor1());
-    m_line.p2(m_sj->ganchor2());
+    update(state(), sleep_greyout);
+}
+void spring_repr2D::update(const joint_state &state, const float sleep_greyout)
+{
+    // Simplified springs are drawn as straight lines, so there is no point in rebuilding their zig-zag
+    m_anchor1 = state.anchor1;
+    m_anchor2 = state.anchor2;
+    if (detailed)
+        m_line.points(state.anchor1, state.anchor2);
+
+    m_line.color(state.asleep ? sleep_greyout * m_color : m_color);
+}
+
+void spring_repr2D::update(const std::span<spring_repr2D *const> reprs, const std::span<const joint_state> states,
+                           const float sleep_greyout)
+{
+    KIT_ASSERT_ERROR(reprs.size() == states.size(), "The amount of representations and states must match");
+    thread_local std::vector<spring_line2D *> lines;
+    thread_local std::vector<glm::vec2> p1s;
+    thread_local std::vector<glm::vec2> p2s;
+    lines.clear();
+    p1s.clear();
+    p2s.clear();
+
+    for (std::size_t i = 0; i < reprs.size(); i++)
+    {
+        spring_repr2D &srepr = *reprs[i];
+        const joint_state &state = states[i];
+        srepr.m_anchor1 = state.anchor1;
+        srepr.m_anchor2 = state.anchor2;
+        srepr.m_line.color(state.asleep ? sleep_greyout * srepr.m_color : srepr.m_color);
+        if (srepr.detailed)
+        {
+            lines.push_back(&srepr.m_line);
+            p1s.push_back(state.anchor1);
+            p2s.push_back(state.anchor2);
+        }
+    }
+    spring_line2D::rebuild_batch(lines, p1s, p2s);
+}
 
-    m_line.color(m_sj->asleep() ? sleep_greyout * m_color : m_color);
+joint_state spring_repr2D::state() const
+{
+    return {m_sj, m_sj->ganchor1(), m_sj->ganchor2(), 0.f, m_sj->asleep()};
 }
 
-void spring_repr2D::draw(lynx::window2D &window) const
+void spring_repr2D::draw(joint_batches2D &batches) const
+{
+    if (detailed)
+        m_line.draw(batches.lines);
+    else
+        batches.lines.push(m_anchor1, m_anchor2, m_line.color());
+}
+
+const spring_joint2D *spring_repr2D::joint() const
+{
+    return m_sj;
+}
+const spring_line2D &spring_repr2D::line() const
 {
-    window.draw(m_line);
+    return m_line;
 }
 
 } // namespace ppx
\ No newline at end of file
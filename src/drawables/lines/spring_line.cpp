@@ -6,67 +6,146 @@ namespace ppx
 {
 spring_line2D::spring_line2D(const glm::vec2 &p1, const glm::vec2 &p2, const lynx::color &color,
                              const std::size_t supports_count)
-    : m_supports_count(supports_count), m_line_strip(build_line_points(p1, p2), color)
+    : m_supports_count(supports_count), m_points(3 + 4 * supports_count, glm::vec2(0.f)), m_color(color)
 {
+    update_line_points(p1, p2);
 }
 spring_line2D::spring_line2D(const lynx::color &color, const std::size_t supports_count)
     : spring_line2D({0.f, 0.f}, {1.f, 0.f}, color, supports_count)
 {
 }
 
-std::vector<glm::vec2> spring_line2D::build_line_points(const glm::vec2 &p1, const glm::vec2 &p2)
+void spring_line2D::update_line_points(const glm::vec2 &p1, const glm::vec2 &p2)
 {
-    std::vector<glm::vec2> points = {p1, p2};
-    points.resize(3 + 4 * m_supports_count);
-
     const glm::vec2 segment = p2 - p1;
-    const float base_length = (glm::length(segment) - m_left_padding - m_right_padding) / m_supports_count,
-                angle = atan2f(segment.y, segment.x);
+    const float length = glm::length(segment);
+    const glm::vec2 dir = length > 0.f ? segment / length : glm::vec2(1.f, 0.f);
+
+    const float base_length = (length - m_left_padding - m_right_padding) / m_supports_count;
+    const float height =
+        sqrtf(std::max(m_min_height, m_supports_length * m_supports_length - base_length * base_length));
+    write_line_points(p1, p2, dir, base_length, height);
+}
 
-    glm::vec2 ref1 = p1 + glm::normalize(segment) * m_left_padding,
-              ref2 = p2 - glm::normalize(segment) * m_right_padding;
-    points[2] = ref1;
+void spring_line2D::write_line_points(const glm::vec2 &p1, const glm::vec2 &p2, const glm::vec2 &dir,
+                                      const float base_length, const float height)
+{
+    // Every support has the same shape, so both sides are computed once
+    const glm::vec2 normal{-dir.y, dir.x};
+    const glm::vec2 side1 = 0.5f * base_length * dir + height * normal;
+    const glm::vec2 side2 = 0.5f * base_length * dir - height * normal;
+    const glm::vec2 step = side1 + side2;
+
+    glm::vec2 ref1 = p1 + dir * m_left_padding;
+    glm::vec2 ref2 = p2 - dir * m_right_padding;
+
+    m_points[0] = p1;
+    m_points[1] = p2;
+    m_points[2] = ref1;
     for (std::size_t i = 0; i < m_supports_count; i++)
     {
-        const float y =
-            sqrtf(std::max(m_min_height, m_supports_length * m_supports_length - base_length * base_length));
-        const glm::vec2 side1 = glm::rotate(glm::vec2(0.5f * base_length, y), angle),
-                        side2 = glm::rotate(glm::vec2(0.5f * base_length, -y), angle);
-
         const std::size_t idx1 = 3 + 2 * i, idx2 = 3 + 2 * m_supports_count + 2 * i;
 
-        points[idx1] = ref1 + side1;
-        points[idx1 + 1] = ref1 + side1 + side2;
+        m_points[idx1] = ref1 + side1;
+        m_points[idx1 + 1] = ref1 + step;
 
-        points[idx2] = ref2 - side1;
-        points[idx2 + 1] = ref2 - side1 - side2;
+        m_points[idx2] = ref2 - side1;
+        m_points[idx2 + 1] = ref2 - step;
 
-        ref1 += side1 + side2;
-        ref2 -= side1 + side2;
+        ref1 += step;
+        ref2 -= step;
     }
+}
 
-    return points;
+void spring_line2D::points(const glm::vec2 &p1, const glm::vec2 &p2)
+{
+    update_line_points(p1, p2);
 }
 
-void spring_line2D::update_line_points(const glm::vec2 &p1, const glm::vec2 &p2)
+void spring_line2D::rebuild_batch(const std::span<spring_line2D *const> lines, const std::span<const glm::vec2> p1s,
+                                  const std::span<const glm::vec2> p2s)
 {
-    const std::vector<glm::vec2> points = build_line_points(p1, p2);
-    for (std::size_t i = 0; i < points.size(); i++)
-        m_line_strip[i].position = points[i];
+    KIT_ASSERT_ERROR(lines.size() == p1s.size() && lines.size() == p2s.size(),
+                     "The amount of lines and endpoints must match");
+    thread_local std::vector<float> paddings;
+    thread_local std::vector<float> supports;
+    thread_local std::vector<float> supports_lengths;
+    thread_local std::vector<float> min_heights;
+    thread_local std::vector<float> dxs;
+    thread_local std::vector<float> dys;
+    thread_local std::vector<float> lengths;
+    thread_local std::vector<float> heights;
+
+    const std::size_t count = lines.size();
+    for (std::vector<float> *array :
+         {&paddings, &supports, &supports_lengths, &min_heights, &dxs, &dys, &lengths, &heights})
+        array->resize(count);
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const spring_line2D &line = *lines[i];
+        paddings[i] = line.m_left_padding + line.m_right_padding;
+        supports[i] = static_cast<float>(line.m_supports_count);
+        supports_lengths[i] = line.m_supports_length * line.m_supports_length;
+        min_heights[i] = line.m_min_height;
+    }
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        dxs[i] = p2s[i].x - p1s[i].x;
+        dys[i] = p2s[i].y - p1s[i].y;
+        lengths[i] = sqrtf(dxs[i] * dxs[i] + dys[i] * dys[i]);
+    }
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const bool degenerate = lengths[i] <= 0.f;
+        const float inv_length = degenerate ? 0.f : 1.f / lengths[i];
+        dxs[i] = degenerate ? 1.f : dxs[i] * inv_length;
+        dys[i] = dys[i] * inv_length;
+    }
+    for (std::size_t i = 0; i < count; i++)
+    {
+        lengths[i] = (lengths[i] - paddings[i]) / supports[i];
+        heights[i] = sqrtf(std::max(min_heights[i], supports_lengths[i] - lengths[i] * lengths[i]));
+    }
+
+    for (std::size_t i = 0; i < count; i++)
+        lines[i]->write_line_points(p1s[i], p2s[i], {dxs[i], dys[i]}, lengths[i], heights[i]);
 }
 
 void spring_line2D::draw(lynx::window2D &window) const
 {
-    window.draw(m_line_strip);
+    if (!m_line_strip)
+        m_line_strip = kit::make_scope<lynx::line_strip2D>(m_points, m_color);
+    else
+    {
+        for (std::size_t i = 0; i < m_points.size(); i++)
+            (*m_line_strip)[i].position = m_points[i];
+        m_line_strip->color(m_color);
+    }
+    m_line_strip->parent(m_parent);
+    window.draw(*m_line_strip);
+}
+
+void spring_line2D::draw(line_batch2D &batch) const
+{
+    const glm::mat3 transform = m_parent ? m_parent->ftransform() : glm::mat3(1.f);
+    glm::vec2 previous = transform * glm::vec3(m_points[0], 1.f);
+    for (std::size_t i = 1; i < m_points.size(); i++)
+    {
+        const glm::vec2 current = transform * glm::vec3(m_points[i], 1.f);
+        batch.push(previous, current, m_color);
+        previous = current;
+    }
 }
 
 const glm::vec2 &spring_line2D::p1() const
 {
-    return m_line_strip[0].position;
+    return m_points[0];
 }
 const glm::vec2 &spring_line2D::p2() const
 {
-    return m_line_strip[1].position;
+    return m_points[1];
 }
 
 void spring_line2D::p1(const glm::vec2 &p1)
@@ -80,26 +159,30 @@ void spring_line2D::p2(const glm::vec2 &p2)
 
 const lynx::color &spring_line2D::color() const
 {
-    return m_line_strip.color();
+    return m_color;
 }
 void spring_line2D::color(const lynx::color &color)
 {
-    m_line_strip.color(color);
+    m_color = color;
 }
 
 const kit::transform2D<float> *spring_line2D::parent() const
 {
-    return m_line_strip.parent();
+    return m_parent;
 }
 void spring_line2D::parent(const kit::transform2D<float> *parent)
 {
-    m_line_strip.parent(parent);
+    m_parent = parent;
 }
 
 std::size_t spring_line2D::supports_count() const
 {
     return m_supports_count;
 }
+std::size_t spring_line2D::memory() const
+{
+    return m_points.capacity() * sizeof(glm::vec2);
+}
 float spring_line2D::supports_length() const
 {
     return m_supports_length;
@@ -5,100 +5,92 @@
 namespace ppx
 {
 thick_line2D::thick_line2D(const glm::vec2 &p1, const glm::vec2 &p2, const lynx::color &color, const float width)
-    : m_rect(color), m_circle1(color), m_circle2(color)
+    : m_p1(p1), m_p2(p2), m_color(color), m_width(width)
 {
-    m_circle1.transform.position = p1;
-    m_circle2.transform.position = p2;
-
-    update_width(width);
-    update_orientation();
 }
 thick_line2D::thick_line2D(const lynx::color &color, const float width)
     : thick_line2D({0.f, 0.f}, {1.f, 0.f}, color, width)
 {
 }
 
-void thick_line2D::update_width(const float width)
-{
-    m_circle1.radius(0.5f * width);
-    m_circle2.radius(0.5f * width);
-
-    m_rect.transform.scale.y = width;
-}
-
-void thick_line2D::update_length()
-{
-    m_rect.transform.scale.x = glm::distance(m_circle1.transform.position, m_circle2.transform.position);
-}
-
-void thick_line2D::update_orientation()
+void thick_line2D::draw(lynx::window2D &window) const
 {
-    const glm::vec2 &p1 = m_circle1.transform.position;
-    const glm::vec2 &p2 = m_circle2.transform.position;
-
-    m_rect.transform.position = 0.5f * (p1 + p2);
-
-    const glm::vec2 dp = p2 - p1;
-    m_rect.transform.rotation = atan2f(dp.y, dp.x);
+    if (!m_mesh)
+        m_mesh = kit::make_scope<capsule_batch2D>(12);
+    if (m_mesh_dirty || m_parent)
+    {
+        m_mesh->clear();
+        draw(*m_mesh);
+        m_mesh_dirty = false;
+    }
+    window.draw(*m_mesh);
 }
 
-void thick_line2D::draw(lynx::window2D &window) const
+void thick_line2D::draw(capsule_batch2D &batch) const
 {
-    window.draw(m_rect);
-    window.draw(m_circle1);
-    window.draw(m_circle2);
+    if (!m_parent)
+    {
+        batch.push(m_p1, m_p2, 0.5f * m_width, m_color);
+        return;
+    }
+    const glm::mat3 transform = m_parent->ftransform();
+    batch.push(glm::vec2(transform * glm::vec3(m_p1, 1.f)), glm::vec2(transform * glm::vec3(m_p2, 1.f)),
+               0.5f * m_width, m_color);
 }
 
 const glm::vec2 &thick_line2D::p1() const
 {
-    return m_circle1.transform.position;
+    return m_p1;
 }
 const glm::vec2 &thick_line2D::p2() const
 {
-    return m_circle2.transform.position;
+    return m_p2;
 }
 
 void thick_line2D::p1(const glm::vec2 &p1)
 {
-    m_circle1.transform.position = p1;
-    update_length();
-    update_orientation();
+    m_p1 = p1;
+    m_mesh_dirty = true;
 }
 void thick_line2D::p2(const glm::vec2 &p2)
 {
-    m_circle2.transform.position = p2;
-    update_length();
-    update_orientation();
+    m_p2 = p2;
+    m_mesh_dirty = true;
+}
+void thick_line2D::points(const glm::vec2 &p1, const glm::vec2 &p2)
+{
+    m_p1 = p1;
+    m_p2 = p2;
+    m_mesh_dirty = true;
 }
 
 const lynx::color &thick_line2D::color() const
 {
-    return m_rect.color();
+    return m_color;
 }
 void thick_line2D::color(const lynx::color &color)
 {
-    m_rect.color(color);
-    m_circle1.color(color);
-    m_circle2.color(color);
+    m_color = color;
+    m_mesh_dirty = true;
 }
 
 const kit::transform2D<float> *thick_line2D::parent() const
 {
-    return m_rect.transform.parent;
+    return m_parent;
 }
 void thick_line2D::parent(const kit::transform2D<float> *parent)
 {
-    m_rect.transform.parent = parent;
-    m_circle1.transform.parent = parent;
-    m_circle2.transform.parent = parent;
+    m_parent = parent;
+    m_mesh_dirty = true;
 }
 
 float thick_line2D::width() const
 {
-    return m_rect.transform.scale.y;
+    return m_width;
 }
 void thick_line2D::width(const float width)
 {
-    update_width(width);
+    m_width = width;
+    m_mesh_dirty = true;
 }
-} // namespace ppx
\ No newline at end of file
+} // namespace ppx
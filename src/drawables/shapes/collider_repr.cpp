@@ -1,34 +1,80 @@
 #include "ppx-app/internal/pch.hpp"
 #include "ppx-app/drawables/shapes/collider_repr.hpp"
-#include "ppx-app/drawables/shapes/oriented_nsphere.hpp"
 
 namespace ppx
 {
-collider_repr2D::collider_repr2D(collider2D *collider, const lynx::color &color, const float sleep_greyout)
-    : collider(collider), color(color)
-{
-    if (const auto *c = collider->shape_if<circle>())
-        shape = kit::make_scope<oriented_circle>(c->radius(), color);
-    else
-    {
-        const polygon &poly = collider->shape<polygon>();
-        const std::vector<glm::vec2> vertices{poly.vertices.model.begin(), poly.vertices.model.end()};
-        shape = kit::make_scope<lynx::polygon2D>(vertices, color);
-    }
-    update(sleep_greyout);
+collider_repr2D::collider_repr2D(collider2D *collider, const lynx::color &color)
+    : collider(collider), color(color), m_display_color(color), m_applied_color(color)
+{
 }
 
 void collider_repr2D::update(const float sleep_greyout)
 {
-    const glm::vec2 scale = shape->transform.scale;
-    shape->transform = collider->ltransform();
-    shape->transform.scale = scale;
-    shape->color(collider->body()->asleep() ? color * sleep_greyout : color);
+    m_transform = collider->ltransform().ftransform();
+    apply_color(collider->body()->asleep(), sleep_greyout);
+}
+
+void collider_repr2D::update(const float sleep_greyout, const std::uint64_t frame)
+{
+    const bool asleep = collider->body()->asleep();
+    if (color.rgba == m_applied_color.rgba && m_tracker.up_to_date(asleep, sleep_greyout, frame))
+        return;
+    m_transform = collider->ltransform().ftransform();
+    apply_color(asleep, sleep_greyout);
+    m_tracker.updated(asleep, sleep_greyout, frame);
+}
+void collider_repr2D::update(const collider_state &state, const float sleep_greyout, const std::uint64_t frame)
+{
+    if (color.rgba == m_applied_color.rgba && m_tracker.up_to_date(state.asleep, sleep_greyout, frame))
+        return;
+    m_transform = state.transform();
+    apply_color(state.asleep, sleep_greyout);
+    m_tracker.updated(state.asleep, sleep_greyout, frame);
+}
+
+void collider_repr2D::apply_color(const bool asleep, const float sleep_greyout)
+{
+    m_display_color = asleep ? color * sleep_greyout : color;
+    m_applied_color = color;
+}
+
+void collider_repr2D::mark_dirty()
+{
+    m_tracker.mark_dirty();
+}
+
+const glm::mat3 &collider_repr2D::transform() const
+{
+    return m_transform;
+}
+const lynx::color &collider_repr2D::display_color() const
+{
+    return m_display_color;
+}
+
+circle_repr2D::circle_repr2D(collider2D *collider, const lynx::color &color, const float sleep_greyout)
+    : collider_repr2D(collider, color), radius(collider->shape<circle>().radius())
+{
+    update(sleep_greyout);
+}
+
+void circle_repr2D::draw(collider_batch2D &batch) const
+{
+    batch.push_circle(m_transform, radius, m_display_color);
+}
+
+polygon_repr2D::polygon_repr2D(collider2D *collider, polygon_mesh_cache &meshes, const lynx::color &color,
+                               const float sleep_greyout)
+    : collider_repr2D(collider, color)
+{
+    const polygon &poly = collider->shape<polygon>();
+    mesh = meshes.acquire(poly.vertices.model.begin(), poly.vertices.model.end());
+    update(sleep_greyout);
 }
 
-void collider_repr2D::draw(lynx::window2D &window) const
+void polygon_repr2D::draw(collider_batch2D &batch) const
 {
-    window.draw(*shape);
+    batch.push_polygon(m_transform, mesh.mesh(), m_display_color);
 }
 
-} // namespace ppx
\ No newline at end of file
+} // namespace ppx
@@ -0,0 +1,138 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/drawables/shapes/polygon_mesh.hpp"
+
+#include <cstring>
+
+namespace ppx
+{
+static std::size_t hash_vertices(const std::vector<glm::vec2> &vertices)
+{
+    // FNV-1a over the raw bits, as meshes are only shared between exactly equal outlines
+    std::size_t hash = 14695981039346656037ull;
+    for (const glm::vec2 &vertex : vertices)
+        for (const float component : {vertex.x, vertex.y})
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &component, sizeof(bits));
+            hash = (hash ^ bits) * 1099511628211ull;
+        }
+    return hash;
+}
+
+polygon_mesh_cache::handle::handle(polygon_mesh_cache *cache, const std::uint32_t id) : m_cache(cache), m_id(id)
+{
+}
+
+polygon_mesh_cache::handle::~handle()
+{
+    release();
+}
+
+polygon_mesh_cache::handle::handle(handle &&other) noexcept : m_cache(other.m_cache), m_id(other.m_id)
+{
+    other.m_cache = nullptr;
+}
+
+polygon_mesh_cache::handle &polygon_mesh_cache::handle::operator=(handle &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+    release();
+    m_cache = other.m_cache;
+    m_id = other.m_id;
+    other.m_cache = nullptr;
+    return *this;
+}
+
+void polygon_mesh_cache::handle::release()
+{
+    if (m_cache)
+        m_cache->release(m_id);
+    m_cache = nullptr;
+}
+
+const polygon_mesh &polygon_mesh_cache::handle::mesh() const
+{
+    KIT_ASSERT_ERROR(m_cache, "Cannot access the mesh of an empty handle");
+    return m_cache->m_entries[m_id].mesh;
+}
+std::uint32_t polygon_mesh_cache::handle::id() const
+{
+    return m_id;
+}
+
+polygon_mesh_cache::handle polygon_mesh_cache::acquire_scratch()
+{
+    KIT_ASSERT_ERROR(m_scratch.size() >= 3, "A polygon mesh must have at least 3 vertices");
+    const std::size_t hash = hash_vertices(m_scratch);
+    const auto [first, last] = m_lookup.equal_range(hash);
+    for (auto it = first; it != last; ++it)
+    {
+        entry &existing = m_entries[it->second];
+        if (existing.mesh.vertices == m_scratch)
+        {
+            existing.references++;
+            m_references++;
+            return handle(this, it->second);
+        }
+    }
+
+    std::uint32_t id;
+    if (m_free.empty())
+    {
+        id = static_cast<std::uint32_t>(m_entries.size());
+        m_entries.emplace_back();
+    }
+    else
+    {
+        id = m_free.back();
+        m_free.pop_back();
+    }
+
+    entry &created = m_entries[id];
+    created.mesh.vertices = m_scratch;
+    created.mesh.radius = 0.f;
+    for (const glm::vec2 &vertex : m_scratch)
+        created.mesh.radius = std::max(created.mesh.radius, glm::length(vertex));
+    created.hash = hash;
+    created.references = 1;
+    m_references++;
+    m_lookup.emplace(hash, id);
+    return handle(this, id);
+}
+
+void polygon_mesh_cache::release(const std::uint32_t id)
+{
+    entry &released = m_entries[id];
+    KIT_ASSERT_ERROR(released.references > 0, "Mesh {0} has no references left to release", id);
+    m_references--;
+    if (--released.references != 0)
+        return;
+
+    const auto [first, last] = m_lookup.equal_range(released.hash);
+    for (auto it = first; it != last; ++it)
+        if (it->second == id)
+        {
+            m_lookup.erase(it);
+            break;
+        }
+    released.mesh.vertices = {};
+    m_free.push_back(id);
+}
+
+std::size_t polygon_mesh_cache::size() const
+{
+    return m_entries.size() - m_free.size();
+}
+std::size_t polygon_mesh_cache::references() const
+{
+    return m_references;
+}
+std::size_t polygon_mesh_cache::memory() const
+{
+    std::size_t bytes = 0;
+    for (const entry &e : m_entries)
+        bytes += e.mesh.vertices.capacity() * sizeof(glm::vec2);
+    return bytes;
+}
+} // namespace ppx
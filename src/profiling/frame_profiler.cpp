@@ -0,0 +1,157 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/profiling/frame_profiler.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+
+namespace ppx
+{
+bool frame_profiler::enabled()
+{
+    return s_enabled;
+}
+void frame_profiler::enabled(const bool enabled)
+{
+    s_enabled = enabled;
+    if (!enabled)
+        s_recording = false;
+}
+
+float frame_profiler::elapsed()
+{
+    return std::chrono::duration<float, std::milli>(clock::now() - s_frame_start).count();
+}
+
+void frame_profiler::begin_frame()
+{
+    if (s_recording)
+    {
+        s_frames[s_head].duration = elapsed();
+        s_head = (s_head + 1) % capacity;
+        s_count = std::min(s_count + 1, capacity);
+    }
+
+    s_recording = s_enabled;
+    if (!s_recording)
+        return;
+
+    s_owner = std::this_thread::get_id();
+    s_frame_start = clock::now();
+    s_depth = 0;
+    s_frames[s_head].scopes.clear();
+}
+
+std::size_t frame_profiler::begin_scope(const char *name)
+{
+    if (!s_recording || std::this_thread::get_id() != s_owner)
+        return npos;
+    std::vector<scope_record> &scopes = s_frames[s_head].scopes;
+    scopes.push_back({name, s_depth++, elapsed(), 0.f});
+    return scopes.size() - 1;
+}
+
+void frame_profiler::end_scope(const std::size_t index)
+{
+    if (index == npos || !s_recording)
+        return;
+    std::vector<scope_record> &scopes = s_frames[s_head].scopes;
+    if (index >= scopes.size())
+        return;
+    scopes[index].duration = elapsed() - scopes[index].start;
+    s_depth--;
+}
+
+std::size_t frame_profiler::frame_count()
+{
+    return s_count;
+}
+
+std::size_t frame_profiler::memory()
+{
+    std::size_t bytes = vector_bytes(s_frames);
+    for (const frame_record &record : s_frames)
+        bytes += vector_bytes(record.scopes);
+    return bytes;
+}
+
+const frame_profiler::frame_record &frame_profiler::frame(const std::size_t age)
+{
+    KIT_ASSERT_ERROR(age < s_count, "Frame age {0} exceeds the amount of recorded frames", age);
+    return s_frames[(s_head + capacity - 1 - age) % capacity];
+}
+
+static void fill_percentiles(std::vector<float> &samples, frame_profiler::scope_stats &stats)
+{
+    if (samples.empty())
+        return;
+    float total = 0.f;
+    for (const float sample : samples)
+        total += sample;
+    stats.average = total / static_cast<float>(samples.size());
+
+    const auto percentile = [&samples](const float p) {
+        const auto nth = samples.begin() + static_cast<std::ptrdiff_t>(p * static_cast<float>(samples.size() - 1));
+        std::nth_element(samples.begin(), nth, samples.end());
+        return *nth;
+    };
+    stats.p50 = percentile(0.5f);
+    stats.p99 = percentile(0.99f);
+}
+
+void frame_profiler::compute_stats(std::vector<scope_stats> &stats)
+{
+    stats.clear();
+    if (s_count == 0)
+        return;
+
+    thread_local std::vector<float> samples;
+    const frame_record &last = frame(0);
+    for (const scope_record &record : last.scopes)
+    {
+        const std::string_view name = record.name;
+        if (std::any_of(stats.begin(), stats.end(), [name](const scope_stats &st) { return st.name == name; }))
+            continue;
+
+        samples.clear();
+        for (std::size_t age = 0; age < s_count; age++)
+        {
+            float duration = 0.f;
+            bool found = false;
+            for (const scope_record &r : frame(age).scopes)
+                if (name == r.name)
+                {
+                    duration += r.duration;
+                    found = true;
+                }
+            if (found)
+                samples.push_back(duration);
+        }
+
+        scope_stats &st = stats.emplace_back();
+        st.name = name;
+        st.depth = record.depth;
+        st.last = samples.front();
+        fill_percentiles(samples, st);
+    }
+}
+
+void frame_profiler::compute_frame_stats(scope_stats &stats)
+{
+    stats = {"Frame", 0, 0.f, 0.f, 0.f, 0.f};
+    if (s_count == 0)
+        return;
+
+    thread_local std::vector<float> samples;
+    samples.clear();
+    for (std::size_t age = 0; age < s_count; age++)
+        samples.push_back(frame(age).duration);
+    stats.last = samples.front();
+    fill_percentiles(samples, stats);
+}
+
+profile_scope::profile_scope(const char *name) : m_index(frame_profiler::begin_scope(name))
+{
+}
+profile_scope::~profile_scope()
+{
+    frame_profiler::end_scope(m_index);
+}
+} // namespace ppx
@@ -0,0 +1,42 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+
+namespace ppx
+{
+void memory_report::clear()
+{
+    m_entries.clear();
+}
+
+void memory_report::add(const std::string_view subsystem, const std::string_view name, const std::size_t count,
+                        const std::size_t cpu_bytes, const std::size_t gpu_bytes)
+{
+    m_entries.push_back({std::string(subsystem), std::string(name), count, cpu_bytes, gpu_bytes});
+}
+
+const std::vector<memory_report::entry> &memory_report::entries() const
+{
+    return m_entries;
+}
+
+std::size_t memory_report::cpu_bytes() const
+{
+    std::size_t bytes = 0;
+    for (const entry &e : m_entries)
+        bytes += e.cpu_bytes;
+    return bytes;
+}
+std::size_t memory_report::gpu_bytes() const
+{
+    std::size_t bytes = 0;
+    for (const entry &e : m_entries)
+        bytes += e.gpu_bytes;
+    return bytes;
+}
+
+bool memory_report::exceeds(const budget &limits) const
+{
+    return (limits.cpu_bytes != 0 && cpu_bytes() > limits.cpu_bytes) ||
+           (limits.gpu_bytes != 0 && gpu_bytes() > limits.gpu_bytes);
+}
+} // namespace ppx
@@ -0,0 +1,137 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/profiling/world_telemetry.hpp"
+
+#include <fstream>
+
+namespace ppx
+{
+void world_telemetry::sample(const world2D &world, job_pool &jobs, const kit::perf::time step_time)
+{
+    if (!due())
+        return;
+    const std::size_t chunk = prepare(world);
+
+    // Each chunk owns its partial, so the sums need no synchronization and keep their order
+    jobs.parallel_for(
+        0, world.bodies.size(),
+        [this, &world, chunk](const std::size_t start, const std::size_t end) {
+            reduce(world, start, end, m_partials[start / chunk]);
+        },
+        chunk);
+    finish(world, step_time);
+}
+
+void world_telemetry::sample(const world2D &world, const kit::perf::time step_time)
+{
+    if (!due())
+        return;
+    const std::size_t chunk = prepare(world);
+    const std::size_t bodies = world.bodies.size();
+    for (std::size_t start = 0; start < bodies; start += chunk)
+        reduce(world, start, std::min(start + chunk, bodies), m_partials[start / chunk]);
+    finish(world, step_time);
+}
+
+bool world_telemetry::due()
+{
+    if (!enabled.load(std::memory_order_relaxed))
+        return false;
+    return m_steps++ % std::max(interval.load(std::memory_order_relaxed), 1u) == 0;
+}
+
+std::size_t world_telemetry::prepare(const world2D &world)
+{
+    const std::size_t chunk = std::max<std::size_t>(grain, 1);
+    m_partials.assign((world.bodies.size() + chunk - 1) / chunk, partial{0, 0.0});
+    return chunk;
+}
+
+void world_telemetry::reduce(const world2D &world, const std::size_t start, const std::size_t end,
+                             partial &result) const
+{
+    for (std::size_t i = start; i < end; i++)
+    {
+        const body2D *body = world.bodies[i];
+        if (body->asleep())
+            result.sleeping_bodies++;
+        result.kinetic_energy += body->kinetic_energy();
+    }
+}
+
+void world_telemetry::finish(const world2D &world, const kit::perf::time step_time)
+{
+    telemetry_sample sample;
+    sample.step = m_steps - 1;
+    sample.step_time = 1000.f * step_time.as<kit::perf::time::seconds, float>();
+    sample.timestep = world.integrator.ts.value;
+    sample.bodies = static_cast<std::uint32_t>(world.bodies.size());
+    sample.colliders = static_cast<std::uint32_t>(world.colliders.size());
+    sample.contacts = static_cast<std::uint32_t>(world.collisions.size());
+    sample.islands = static_cast<std::uint32_t>(world.islands.size());
+
+    double kinetic_energy = 0.0;
+    for (const partial &p : m_partials)
+    {
+        sample.sleeping_bodies += p.sleeping_bodies;
+        kinetic_energy += p.kinetic_energy;
+    }
+    sample.kinetic_energy = static_cast<float>(kinetic_energy);
+    push(sample);
+}
+
+void world_telemetry::push(const telemetry_sample &sample)
+{
+    const std::uint64_t index = m_written.load(std::memory_order_relaxed);
+    slot &s = m_slots[index % capacity];
+    s.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.sample = sample;
+    s.sequence.store(2 * index + 2, std::memory_order_release);
+    m_written.store(index + 1, std::memory_order_release);
+}
+
+void world_telemetry::read(std::vector<telemetry_sample> &samples) const
+{
+    samples.clear();
+    const std::uint64_t written = m_written.load(std::memory_order_acquire);
+    const std::uint64_t first = written > capacity ? written - capacity : 0;
+    samples.reserve(static_cast<std::size_t>(written - first));
+    for (std::uint64_t index = first; index < written; index++)
+    {
+        const slot &s = m_slots[index % capacity];
+        const std::uint64_t sequence = s.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * index + 2)
+            continue;
+        const telemetry_sample sample = s.sample;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.sequence.load(std::memory_order_relaxed) == sequence)
+            samples.push_back(sample);
+    }
+}
+
+std::uint64_t world_telemetry::total_samples() const
+{
+    return m_written.load(std::memory_order_acquire);
+}
+
+std::size_t world_telemetry::memory() const
+{
+    return m_slots.capacity() * sizeof(slot) + m_partials.capacity() * sizeof(partial);
+}
+
+bool world_telemetry::write_csv(const std::filesystem::path &path) const
+{
+    std::vector<telemetry_sample> samples;
+    read(samples);
+
+    std::ofstream file{path, std::ios::trunc};
+    if (!file)
+        return false;
+    file << "step,step_time_ms,timestep,bodies,sleeping_bodies,colliders,contacts,islands,kinetic_energy\n";
+    for (const telemetry_sample &sample : samples)
+        file << sample.step << ',' << sample.step_time << ',' << sample.timestep << ',' << sample.bodies << ','
+             << sample.sleeping_bodies << ',' << sample.colliders << ',' << sample.contacts << ',' << sample.islands
+             << ',' << sample.kinetic_energy << '\n';
+    return static_cast<bool>(file);
+}
+} // namespace ppx
@@ -0,0 +1,314 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/replay/replay_codec.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+#include "ppx/world.hpp"
+#include "ppx/joints/spring_joint.hpp"
+#include "ppx/joints/distance_joint.hpp"
+#include "ppx/joints/prismatic_joint.hpp"
+#include "ppx/joints/revolute_joint.hpp"
+#include "ppx/joints/weld_joint.hpp"
+#include "ppx/joints/rotor_joint.hpp"
+#include "ppx/joints/motor_joint.hpp"
+#include "ppx/joints/ball_joint.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace ppx
+{
+static constexpr std::size_t collider_track = 0;
+static constexpr std::uint32_t collider_channels = 3;
+static constexpr std::uint32_t joint_channels = 5;
+
+template <typename T> static void write(std::vector<std::byte> &payload, const T *data, const std::size_t count)
+{
+    const std::size_t offset = payload.size();
+    payload.resize(offset + count * sizeof(T));
+    if (count != 0)
+        std::memcpy(payload.data() + offset, data, count * sizeof(T));
+}
+
+template <typename T>
+static bool read(const std::span<const std::byte> payload, std::size_t &cursor, T *data, const std::size_t count)
+{
+    if (count * sizeof(T) > payload.size() - cursor)
+        return false;
+    if (count != 0)
+        std::memcpy(data, payload.data() + cursor, count * sizeof(T));
+    cursor += count * sizeof(T);
+    return true;
+}
+
+template <typename F> static void write_mask(std::vector<std::byte> &payload, const std::uint32_t count, F &&bit)
+{
+    const std::size_t offset = payload.size();
+    payload.resize(offset + (count + 7) / 8, std::byte{0});
+    for (std::uint32_t i = 0; i < count; i++)
+        if (bit(i))
+            payload[offset + i / 8] |= std::byte{static_cast<std::uint8_t>(1u << (i % 8))};
+}
+
+static bool read_mask(const std::span<const std::byte> payload, std::size_t &cursor, const std::uint32_t count,
+                      std::vector<std::uint8_t> &bits)
+{
+    const std::size_t size = (count + 7) / 8;
+    if (size > payload.size() - cursor)
+        return false;
+    bits.resize(count);
+    for (std::uint32_t i = 0; i < count; i++)
+        bits[i] = static_cast<std::uint8_t>((std::to_integer<std::uint8_t>(payload[cursor + i / 8]) >> (i % 8)) & 1u);
+    cursor += size;
+    return true;
+}
+
+replay_codec::replay_codec(const float position_step, const float rotation_step)
+    : m_position_step(position_step), m_rotation_step(rotation_step)
+{
+    KIT_ASSERT_ERROR(position_step > 0.f && rotation_step > 0.f, "Quantization steps must be positive");
+    m_tracks[collider_track].channels = collider_channels;
+    for (std::size_t t = 1; t < m_tracks.size(); t++)
+        m_tracks[t].channels = joint_channels;
+    m_scratch = m_tracks;
+}
+
+std::uint32_t replay_codec::track::count() const
+{
+    return static_cast<std::uint32_t>(values.size() / channels);
+}
+
+float replay_codec::step(const std::size_t track, const std::uint32_t channel) const
+{
+    return track == collider_track && channel == 2 ? m_rotation_step : m_position_step;
+}
+
+void replay_codec::quantize(const world_snapshot &snapshot)
+{
+    const auto q = [](const float value, const float step) {
+        return static_cast<std::int32_t>(std::lround(value / step));
+    };
+
+    track &colliders = m_scratch[collider_track];
+    const track &previous = m_tracks[collider_track];
+    colliders.values.resize(snapshot.colliders.size() * collider_channels);
+    colliders.asleep.resize(snapshot.colliders.size());
+    for (std::size_t i = 0; i < snapshot.colliders.size(); i++)
+    {
+        const collider_state &state = snapshot.colliders[i];
+        float rotation = state.rotation;
+
+        // Rotations are unwrapped against the previous frame so that crossing the -pi/pi boundary is a small delta
+        if (i < previous.count())
+        {
+            const float last = static_cast<float>(previous.values[i * collider_channels + 2]) * m_rotation_step;
+            float drot = rotation - last;
+            drot -= 2.f * glm::pi<float>() * std::round(drot / (2.f * glm::pi<float>()));
+            rotation = last + drot;
+        }
+        colliders.values[i * collider_channels] = q(state.position.x, m_position_step);
+        colliders.values[i * collider_channels + 1] = q(state.position.y, m_position_step);
+        colliders.values[i * collider_channels + 2] = q(rotation, m_rotation_step);
+        colliders.asleep[i] = state.asleep;
+    }
+
+    for (std::size_t t = 0; t < snapshot_joint_states.size(); t++)
+    {
+        track &jtrack = m_scratch[t + 1];
+        const std::vector<joint_state> &states = snapshot.*snapshot_joint_states[t];
+        jtrack.values.resize(states.size() * joint_channels);
+        jtrack.asleep.resize(states.size());
+        for (std::size_t i = 0; i < states.size(); i++)
+        {
+            const joint_state &state = states[i];
+            std::int32_t *values = jtrack.values.data() + i * joint_channels;
+            values[0] = q(state.anchor1.x, m_position_step);
+            values[1] = q(state.anchor1.y, m_position_step);
+            values[2] = q(state.anchor2.x, m_position_step);
+            values[3] = q(state.anchor2.y, m_position_step);
+            values[4] = q(state.value, m_position_step);
+            jtrack.asleep[i] = state.asleep;
+        }
+    }
+}
+
+void replay_codec::encode(const world_snapshot &snapshot, const bool force_key, frame_header &header,
+                          std::vector<std::byte> &payload)
+{
+    quantize(snapshot);
+
+    bool key = force_key;
+    for (std::size_t t = 0; t < m_tracks.size() && !key; t++)
+    {
+        const track &current = m_scratch[t];
+        const track &previous = m_tracks[t];
+        if (current.count() != previous.count())
+            key = true;
+        for (std::size_t i = 0; i < current.values.size() && !key; i++)
+        {
+            const std::int64_t delta = std::int64_t{current.values[i]} - previous.values[i];
+            key = delta < std::numeric_limits<std::int16_t>::min() || delta > std::numeric_limits<std::int16_t>::max();
+        }
+    }
+
+    // Keyframes reset the accumulated rotation unwrapping so that stored values stay bounded
+    if (key)
+    {
+        track &colliders = m_scratch[collider_track];
+        for (std::size_t i = 0; i < snapshot.colliders.size(); i++)
+            colliders.values[i * collider_channels + 2] =
+                static_cast<std::int32_t>(std::lround(snapshot.colliders[i].rotation / m_rotation_step));
+    }
+
+    header.type = key ? frame_type::KEY : frame_type::DELTA;
+    payload.clear();
+    for (std::size_t t = 0; t < m_tracks.size(); t++)
+    {
+        const track &current = m_scratch[t];
+        const track &previous = m_tracks[t];
+        const std::uint32_t count = current.count();
+        header.counts[t] = count;
+
+        write_mask(payload, count, [&current](const std::uint32_t i) { return current.asleep[i] != 0; });
+        if (key)
+        {
+            write(payload, current.values.data(), current.values.size());
+            continue;
+        }
+
+        const auto changed = [&current, &previous](const std::uint32_t i) {
+            for (std::uint32_t c = 0; c < current.channels; c++)
+                if (current.values[i * current.channels + c] != previous.values[i * current.channels + c])
+                    return true;
+            return false;
+        };
+        write_mask(payload, count, changed);
+        for (std::uint32_t i = 0; i < count; i++)
+            if (changed(i))
+                for (std::uint32_t c = 0; c < current.channels; c++)
+                {
+                    const std::size_t index = i * current.channels + c;
+                    const auto delta = static_cast<std::int16_t>(current.values[index] - previous.values[index]);
+                    write(payload, &delta, 1);
+                }
+    }
+    header.size = static_cast<std::uint32_t>(payload.size());
+    std::swap(m_tracks, m_scratch);
+}
+
+bool replay_codec::decode(const frame_header &header, const std::span<const std::byte> payload)
+{
+    std::size_t cursor = 0;
+    std::vector<std::uint8_t> changed;
+    for (std::size_t t = 0; t < m_tracks.size(); t++)
+    {
+        track &current = m_tracks[t];
+        const std::uint32_t count = header.counts[t];
+        if (!read_mask(payload, cursor, count, current.asleep))
+            return false;
+
+        if (header.type == frame_type::KEY)
+        {
+            current.values.resize(std::size_t{count} * current.channels);
+            if (!read(payload, cursor, current.values.data(), current.values.size()))
+                return false;
+            continue;
+        }
+
+        if (current.count() != count || !read_mask(payload, cursor, count, changed))
+            return false;
+        for (std::uint32_t i = 0; i < count; i++)
+            if (changed[i])
+                for (std::uint32_t c = 0; c < current.channels; c++)
+                {
+                    std::int16_t delta;
+                    if (!read(payload, cursor, &delta, 1))
+                        return false;
+                    current.values[i * current.channels + c] += delta;
+                }
+    }
+    return cursor == payload.size();
+}
+
+void replay_codec::reset()
+{
+    for (track &t : m_tracks)
+    {
+        t.values.clear();
+        t.asleep.clear();
+    }
+}
+
+template <typename Joint>
+static void fill_joints(world2D &world, const std::vector<std::int32_t> &values,
+                        const std::vector<std::uint8_t> &asleep, const float step, std::vector<joint_state> &states)
+{
+    states.assign(asleep.size(), joint_state{});
+    for (std::size_t i = 0; i < states.size(); i++)
+    {
+        const std::int32_t *v = values.data() + i * joint_channels;
+        joint_state &state = states[i];
+        state.anchor1 = step * glm::vec2(static_cast<float>(v[0]), static_cast<float>(v[1]));
+        state.anchor2 = step * glm::vec2(static_cast<float>(v[2]), static_cast<float>(v[3]));
+        state.value = step * static_cast<float>(v[4]);
+        state.asleep = asleep[i] != 0;
+    }
+    for (const Joint *joint : *world.joints.manager<Joint>())
+        if (joint->meta.index < states.size())
+            states[joint->meta.index].joint = joint;
+}
+
+void replay_codec::fill(world2D &world, world_snapshot &snapshot) const
+{
+    const track &colliders = m_tracks[collider_track];
+    snapshot.colliders.assign(colliders.count(), collider_state{});
+    for (std::size_t i = 0; i < snapshot.colliders.size(); i++)
+    {
+        const std::int32_t *v = colliders.values.data() + i * collider_channels;
+        collider_state &state = snapshot.colliders[i];
+        state.position = m_position_step * glm::vec2(static_cast<float>(v[0]), static_cast<float>(v[1]));
+        state.rotation = m_rotation_step * static_cast<float>(v[2]);
+        state.asleep = colliders.asleep[i] != 0;
+        state.bounds = {state.position, state.position};
+    }
+
+    // The live collider's bounding box diagonal bounds the collider in any orientation around its recorded position
+    for (const collider2D *collider : world.colliders)
+        if (collider->meta.index < snapshot.colliders.size())
+        {
+            collider_state &state = snapshot.colliders[collider->meta.index];
+            const bounds2D live = collider_state::bounds_of(collider);
+            const glm::vec2 extent{glm::length(live.dimension())};
+            state.collider = collider;
+            state.bounds = {state.position - extent, state.position + extent};
+        }
+
+    // Joint tracks follow the collider track in snapshot_joint_states order
+    const float step = m_position_step;
+    fill_joints<spring_joint2D>(world, m_tracks[1].values, m_tracks[1].asleep, step, snapshot.springs);
+    fill_joints<distance_joint2D>(world, m_tracks[2].values, m_tracks[2].asleep, step, snapshot.distances);
+    fill_joints<prismatic_joint2D>(world, m_tracks[3].values, m_tracks[3].asleep, step, snapshot.prismatics);
+    fill_joints<revolute_joint2D>(world, m_tracks[4].values, m_tracks[4].asleep, step, snapshot.revolutes);
+    fill_joints<weld_joint2D>(world, m_tracks[5].values, m_tracks[5].asleep, step, snapshot.welds);
+    fill_joints<rotor_joint2D>(world, m_tracks[6].values, m_tracks[6].asleep, step, snapshot.rotors);
+    fill_joints<motor_joint2D>(world, m_tracks[7].values, m_tracks[7].asleep, step, snapshot.motors);
+    fill_joints<ball_joint2D>(world, m_tracks[8].values, m_tracks[8].asleep, step, snapshot.balls);
+    snapshot.published = std::chrono::steady_clock::now();
+}
+
+float replay_codec::position_step() const
+{
+    return m_position_step;
+}
+float replay_codec::rotation_step() const
+{
+    return m_rotation_step;
+}
+
+std::size_t replay_codec::memory() const
+{
+    std::size_t bytes = 0;
+    for (const auto *tracks : {&m_tracks, &m_scratch})
+        for (const track &trk : *tracks)
+            bytes += vector_bytes(trk.values) + vector_bytes(trk.asleep);
+    return bytes;
+}
+} // namespace ppx
@@ -0,0 +1,128 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/replay/replay_player.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+
+#include <cstring>
+
+namespace ppx
+{
+bool replay_player::open(const std::filesystem::path &path)
+{
+    close();
+    m_file.open(path, std::ios::binary);
+    if (!m_file)
+        return false;
+
+    replay_codec::file_header header;
+    if (!m_file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, replay_codec::magic, sizeof(header.magic)) != 0 ||
+        header.version != replay_codec::version || header.position_step <= 0.f || header.rotation_step <= 0.f)
+    {
+        close();
+        return false;
+    }
+    m_codec = replay_codec(header.position_step, header.rotation_step);
+
+    m_file.seekg(0, std::ios::end);
+    const auto size = static_cast<std::uint64_t>(m_file.tellg());
+    std::uint64_t offset = sizeof(header);
+
+    // A truncated last frame, left by an interrupted recording, is ignored
+    while (offset + sizeof(replay_codec::frame_header) <= size)
+    {
+        frame_entry entry;
+        entry.offset = offset + sizeof(replay_codec::frame_header);
+        m_file.seekg(static_cast<std::streamoff>(offset));
+        if (!m_file.read(reinterpret_cast<char *>(&entry.header), sizeof(entry.header)) ||
+            entry.offset + entry.header.size > size)
+            break;
+        if (entry.header.type == replay_codec::frame_type::KEY)
+            m_keyframes.push_back(m_frames.size());
+        else if (entry.header.type != replay_codec::frame_type::DELTA || m_keyframes.empty())
+            break;
+        m_frames.push_back(entry);
+        offset = entry.offset + entry.header.size;
+    }
+    m_file.clear();
+    return true;
+}
+
+void replay_player::close()
+{
+    if (m_file.is_open())
+        m_file.close();
+    m_file.clear();
+    m_frames.clear();
+    m_keyframes.clear();
+    m_codec.reset();
+    m_frame = npos;
+}
+
+bool replay_player::is_open() const
+{
+    return m_file.is_open();
+}
+
+bool replay_player::decode(const std::uint64_t frame)
+{
+    const frame_entry &entry = m_frames[frame];
+    m_payload.resize(entry.header.size);
+    m_file.seekg(static_cast<std::streamoff>(entry.offset));
+    if (!m_file.read(reinterpret_cast<char *>(m_payload.data()), static_cast<std::streamsize>(m_payload.size())) ||
+        !m_codec.decode(entry.header, m_payload))
+    {
+        m_file.clear();
+        m_codec.reset();
+        m_frame = npos;
+        return false;
+    }
+    m_frame = frame;
+    return true;
+}
+
+bool replay_player::seek(const std::uint64_t frame)
+{
+    KIT_PERF_SCOPE("ppx::replay_player::seek")
+    if (frame >= m_frames.size())
+        return false;
+    if (frame == m_frame)
+        return true;
+
+    std::uint64_t start = m_frame == npos || frame < m_frame ? 0 : m_frame + 1;
+    const auto key = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), frame) - 1;
+    if (*key > start || start == 0)
+    {
+        m_codec.reset();
+        start = *key;
+    }
+
+    for (std::uint64_t f = start; f <= frame; f++)
+        if (!decode(f))
+            return false;
+    return true;
+}
+
+bool replay_player::advance()
+{
+    return seek(m_frame == npos ? 0 : m_frame + 1);
+}
+
+std::uint64_t replay_player::frame() const
+{
+    return m_frame;
+}
+std::uint64_t replay_player::frame_count() const
+{
+    return m_frames.size();
+}
+
+std::size_t replay_player::memory() const
+{
+    return vector_bytes(m_frames) + vector_bytes(m_keyframes) + vector_bytes(m_payload) + m_codec.memory();
+}
+
+void replay_player::fill(world2D &world, world_snapshot &snapshot) const
+{
+    m_codec.fill(world, snapshot);
+}
+} // namespace ppx
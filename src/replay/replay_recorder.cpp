@@ -0,0 +1,87 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/replay/replay_recorder.hpp"
+#include "ppx-app/profiling/memory_report.hpp"
+
+#include <cstring>
+
+namespace ppx
+{
+bool replay_recorder::open(const std::filesystem::path &path)
+{
+    return open(path, specs{});
+}
+bool replay_recorder::open(const std::filesystem::path &path, const specs &spc)
+{
+    KIT_ASSERT_ERROR(spc.keyframe_interval > 0, "Keyframe interval must be positive");
+    close();
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+        return false;
+
+    m_codec = replay_codec(spc.position_step, spc.rotation_step);
+    m_keyframe_interval = spc.keyframe_interval;
+    m_frames = 0;
+    m_keyframes = 0;
+
+    replay_codec::file_header header{};
+    std::memcpy(header.magic, replay_codec::magic, sizeof(header.magic));
+    header.version = replay_codec::version;
+    header.position_step = spc.position_step;
+    header.rotation_step = spc.rotation_step;
+    header.keyframe_interval = spc.keyframe_interval;
+    m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    m_bytes = sizeof(header);
+    return static_cast<bool>(m_file);
+}
+
+void replay_recorder::close()
+{
+    if (m_file.is_open())
+        m_file.close();
+}
+
+bool replay_recorder::recording() const
+{
+    return m_file.is_open();
+}
+
+void replay_recorder::record(const world_snapshot &snapshot)
+{
+    KIT_PERF_SCOPE("ppx::replay_recorder::record")
+    if (!recording())
+        return;
+
+    m_codec.encode(snapshot, m_frames % m_keyframe_interval == 0, m_header, m_payload);
+    m_file.write(reinterpret_cast<const char *>(&m_header), sizeof(m_header));
+    m_file.write(reinterpret_cast<const char *>(m_payload.data()), static_cast<std::streamsize>(m_payload.size()));
+    if (!m_file)
+    {
+        KIT_ERROR("Failed to write replay frame {0}. Recording stopped", m_frames);
+        close();
+        return;
+    }
+
+    m_frames++;
+    if (m_header.type == replay_codec::frame_type::KEY)
+        m_keyframes++;
+    m_bytes += sizeof(m_header) + m_payload.size();
+}
+
+std::uint64_t replay_recorder::frame_count() const
+{
+    return m_frames;
+}
+std::uint64_t replay_recorder::keyframe_count() const
+{
+    return m_keyframes;
+}
+std::uint64_t replay_recorder::bytes_written() const
+{
+    return m_bytes;
+}
+
+std::size_t replay_recorder::memory() const
+{
+    return vector_bytes(m_payload) + m_codec.memory();
+}
+} // namespace ppx
@@ -0,0 +1,217 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/serialization/async_saver.hpp"
+
+#include <fstream>
+
+namespace ppx
+{
+async_saver::async_saver(const std::size_t memory_limit) : m_memory_limit(memory_limit)
+{
+    m_thread = std::thread(&async_saver::run, this);
+}
+
+async_saver::~async_saver()
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        m_running = false;
+    }
+    m_queued.notify_one();
+    m_thread.join();
+}
+
+bool async_saver::save(const simulation &sim, const binary_snapshot::view_state &view,
+                       const std::filesystem::path &path, callback on_complete, callback on_error)
+{
+    KIT_PERF_SCOPE("ppx::async_saver::save")
+    PPX_PROFILE_SCOPE("ppx::async_saver::save")
+    request req{{}, 0, {}, std::move(on_complete), std::move(on_error)};
+    req.res.path = path;
+
+    // Checked before capturing too, so that a rejected save costs no copy
+    if (!admits(2 * binary_snapshot::estimate(sim, view)))
+    {
+        reject(req);
+        return false;
+    }
+
+    const kit::perf::clock capture_clock;
+    req.contents = binary_snapshot::capture(sim, view);
+    req.size = req.contents.size() + binary_snapshot::packed_size(req.contents);
+    req.res.capture_time = capture_clock.elapsed();
+    {
+        std::scoped_lock lock(m_mutex);
+        if (admits_locked(req.size))
+        {
+            m_buffered += req.size;
+            m_requests.push_back(std::move(req));
+            m_queued.notify_one();
+            return true;
+        }
+    }
+    reject(req);
+    return false;
+}
+
+bool async_saver::admits(const std::size_t size) const
+{
+    std::scoped_lock lock(m_mutex);
+    return admits_locked(size);
+}
+bool async_saver::admits_locked(const std::size_t size) const
+{
+    const bool busy = !m_requests.empty() || m_writing;
+    return !busy || m_buffered + size <= m_memory_limit;
+}
+
+void async_saver::reject(request &req)
+{
+    req.contents = {};
+    req.res.error = "Memory limit for queued saves exceeded";
+    dispatch(req);
+}
+
+void async_saver::run()
+{
+    for (;;)
+    {
+        std::unique_lock lock(m_mutex);
+        m_queued.wait(lock, [this]() { return !m_requests.empty() || !m_running; });
+        if (m_requests.empty())
+            return;
+
+        request req = std::move(m_requests.front());
+        m_requests.pop_front();
+        m_writing = true;
+        lock.unlock();
+
+        write(req);
+        req.contents = {};
+
+        lock.lock();
+        m_buffered -= req.size;
+        m_writing = false;
+        m_finished.push_back(std::move(req));
+        m_idle.notify_all();
+    }
+}
+
+static bool is_yaml(const std::filesystem::path &path)
+{
+#ifdef KIT_USE_YAML_CPP
+    const std::filesystem::path extension = path.extension();
+    return extension == ".yaml" || extension == ".yml";
+#else
+    return false;
+#endif
+}
+
+// YAML scenes are converted through a world of their own, which is safe off the main thread
+static bool write_file(const binary_snapshot::contents &cnt, const std::filesystem::path &path, const bool yaml,
+                       std::size_t &bytes)
+{
+#ifdef KIT_USE_YAML_CPP
+    if (yaml)
+    {
+        // Exceptions cannot leave the saving thread, so YAML errors are reported as a failed write
+        try
+        {
+            YAML::Emitter out;
+            out << binary_snapshot::to_yaml(cnt);
+            bytes = out.size();
+            std::ofstream file{path, std::ios::trunc};
+            file << out.c_str();
+            return static_cast<bool>(file);
+        }
+        catch (const YAML::Exception &)
+        {
+            return false;
+        }
+    }
+#endif
+    const std::vector<std::byte> data = binary_snapshot::pack(cnt);
+    bytes = data.size();
+    return binary_snapshot::save(path, data);
+}
+
+void async_saver::write(request &req)
+{
+    const kit::perf::clock write_clock;
+    std::filesystem::path temporary = req.res.path;
+    temporary += ".tmp";
+    if (!write_file(req.contents, temporary, is_yaml(req.res.path), req.res.bytes))
+        req.res.error = "Failed to write '" + temporary.string() + "'";
+    else
+    {
+        std::error_code ec;
+        std::filesystem::rename(temporary, req.res.path, ec);
+        if (ec)
+            req.res.error = "Failed to replace '" + req.res.path.string() + "': " + ec.message();
+    }
+    if (!req.res.error.empty())
+    {
+        std::error_code ec;
+        std::filesystem::remove(temporary, ec);
+    }
+    req.res.success = req.res.error.empty();
+    req.res.write_time = write_clock.elapsed();
+}
+
+void async_saver::dispatch(const request &req)
+{
+    if (req.res.success)
+    {
+        if (req.on_complete)
+            req.on_complete(req.res);
+    }
+    else
+    {
+        KIT_ERROR("Snapshot save failed: {0}", req.res.error);
+        if (req.on_error)
+            req.on_error(req.res);
+    }
+}
+
+void async_saver::poll()
+{
+    std::deque<request> finished;
+    {
+        std::scoped_lock lock(m_mutex);
+        finished.swap(m_finished);
+    }
+    for (const request &req : finished)
+        dispatch(req);
+}
+
+void async_saver::wait()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_idle.wait(lock, [this]() { return m_requests.empty() && !m_writing; });
+    }
+    poll();
+}
+
+std::size_t async_saver::pending() const
+{
+    std::scoped_lock lock(m_mutex);
+    return m_requests.size() + (m_writing ? 1 : 0);
+}
+
+std::size_t async_saver::buffered_bytes() const
+{
+    std::scoped_lock lock(m_mutex);
+    return m_buffered;
+}
+
+std::size_t async_saver::memory_limit() const
+{
+    std::scoped_lock lock(m_mutex);
+    return m_memory_limit;
+}
+void async_saver::memory_limit(const std::size_t limit)
+{
+    std::scoped_lock lock(m_mutex);
+    m_memory_limit = limit;
+}
+} // namespace ppx
@@ -0,0 +1,729 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/serialization/binary_snapshot.hpp"
+
+#ifdef KIT_USE_YAML_CPP
+#include "ppx/serialization/serialization.hpp"
+#include "kit/serialization/yaml/glm.hpp"
+#include "lynx/serialization/serialization.hpp"
+#endif
+
+#include <fstream>
+
+namespace ppx
+{
+static constexpr char snapshot_magic[4] = {'P', 'P', 'X', 'S'};
+static constexpr std::size_t section_alignment = 16;
+
+static std::size_t align(const std::size_t offset)
+{
+    return (offset + section_alignment - 1) & ~(section_alignment - 1);
+}
+
+static void store(const glm::vec2 &vector, float (&out)[2])
+{
+    out[0] = vector.x;
+    out[1] = vector.y;
+}
+static void store(const lynx::color &color, float (&out)[4])
+{
+    for (glm::length_t i = 0; i < 4; i++)
+        out[i] = color.rgba[i];
+}
+static glm::vec2 load_vec2(const float (&in)[2])
+{
+    return {in[0], in[1]};
+}
+static lynx::color load_color(const float (&in)[4])
+{
+    return lynx::color{glm::vec4{in[0], in[1], in[2], in[3]}};
+}
+
+class section_writer
+{
+  public:
+    template <typename T> void add(const binary_snapshot::section_id id, const std::vector<T> &records)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        m_sections.push_back({id, sizeof(T), records.size(), 0});
+        m_payloads.push_back({reinterpret_cast<const std::byte *>(records.data()), records.size() * sizeof(T)});
+    }
+
+    // Bytes finish() returns. Fills the offsets of the sections if given
+    std::size_t size(std::vector<binary_snapshot::section> *sections = nullptr) const
+    {
+        std::size_t size =
+            align(sizeof(binary_snapshot::header) + m_sections.size() * sizeof(binary_snapshot::section));
+        for (std::size_t i = 0; i < m_sections.size(); i++)
+        {
+            if (sections)
+                (*sections)[i].offset = size;
+            size = align(size + m_payloads[i].size());
+        }
+        return size;
+    }
+
+    std::vector<std::byte> finish() const
+    {
+        std::vector<binary_snapshot::section> sections = m_sections;
+        const std::size_t size = this->size(&sections);
+
+        binary_snapshot::header header{};
+        std::memcpy(header.magic, snapshot_magic, sizeof(snapshot_magic));
+        header.version = binary_snapshot::version;
+        header.byte_order = binary_snapshot::byte_order;
+        header.section_count = static_cast<std::uint32_t>(sections.size());
+        header.size = size;
+
+        std::vector<std::byte> data(size);
+        std::memcpy(data.data(), &header, sizeof(header));
+        std::memcpy(data.data() + sizeof(header), sections.data(), sections.size() * sizeof(binary_snapshot::section));
+        for (std::size_t i = 0; i < sections.size(); i++)
+            if (!m_payloads[i].empty())
+                std::memcpy(data.data() + sections[i].offset, m_payloads[i].data(), m_payloads[i].size());
+        return data;
+    }
+
+  private:
+    std::vector<binary_snapshot::section> m_sections;
+    std::vector<std::span<const std::byte>> m_payloads;
+};
+
+template <typename Table> static void capture_joints(const world2D &world, Table &table)
+{
+    using Joint = typename Table::joint_type;
+    const auto *manager = world.joints.manager<Joint>();
+    table.records.reserve(manager->size());
+    for (const Joint *joint : *manager)
+    {
+        const auto spc = Joint::specs::from_instance(*joint);
+        binary_snapshot::typed_joint_record<Joint> &record = table.records.emplace_back();
+        record.joint.body1 = static_cast<std::uint32_t>(spc.joint.bindex1);
+        record.joint.body2 = static_cast<std::uint32_t>(spc.joint.bindex2);
+        store(spc.joint.ganchor1, record.joint.anchor1);
+        store(spc.joint.ganchor2, record.joint.anchor2);
+        record.joint.bodies_collide = spc.joint.bodies_collide;
+        record.joint.reserved = 0;
+        if constexpr (requires { spc.props; })
+            record.props = spc.props;
+    }
+}
+
+template <typename Joint>
+static void add_joint(world2D &world, const binary_snapshot::typed_joint_record<Joint> &record)
+{
+    typename Joint::specs spc;
+    spc.joint.bindex1 = record.joint.body1;
+    spc.joint.bindex2 = record.joint.body2;
+    spc.joint.ganchor1 = load_vec2(record.joint.anchor1);
+    spc.joint.ganchor2 = load_vec2(record.joint.anchor2);
+    spc.joint.bodies_collide = record.joint.bodies_collide != 0;
+    if constexpr (requires { spc.props; })
+        spc.props = record.props;
+    world.joints.add<Joint>(spc);
+}
+
+#ifdef KIT_USE_YAML_CPP
+template <typename T> static void encode_setting(YAML::Node &node, const char *key, const T &object)
+{
+    node[key] = kit::yaml::codec<T>::encode(object);
+}
+template <typename T> static void decode_setting(const YAML::Node &node, const char *key, T &object)
+{
+    if (const YAML::Node child = node[key])
+        kit::yaml::codec<T>::decode(child, object);
+}
+
+static YAML::Node encode_engine(const world2D &world)
+{
+    YAML::Node node;
+    encode_setting(node, "Integrator", world.integrator);
+    encode_setting(node, "Behaviours", world.behaviours);
+    encode_setting(node, "Collisions", world.collisions);
+    encode_setting(node, "Islands", world.islands);
+    return node;
+}
+
+static void store(const YAML::Node &node, std::vector<char> &out)
+{
+    const std::string text = YAML::Dump(node);
+    out.assign(text.begin(), text.end());
+}
+#endif
+
+std::size_t binary_snapshot::contents::size() const
+{
+    std::size_t joint_bytes = 0;
+    for_each_joint_table([&joint_bytes](const auto &table) {
+        joint_bytes += table.records.size() * sizeof(typename decltype(table.records)::value_type);
+    });
+    return sizeof(app) + bodies.size() * sizeof(body_record) + colliders.size() * sizeof(collider_record) +
+           vertices.size() * sizeof(vertex_record) + joint_bytes + lynx_app.size() + engine.size();
+}
+std::size_t binary_snapshot::contents::joint_count() const
+{
+    std::size_t count = 0;
+    for_each_joint_table([&count](const auto &table) { count += table.records.size(); });
+    return count;
+}
+
+// Colors do not belong to the engine, so they are queried per collider
+template <typename F>
+static void capture_world(const world2D &world, F &&color, binary_snapshot::contents &cnt)
+{
+    std::vector<binary_snapshot::body_record> &bodies = cnt.bodies;
+    std::vector<binary_snapshot::collider_record> &colliders = cnt.colliders;
+    std::vector<binary_snapshot::vertex_record> &vertices = cnt.vertices;
+    bodies.reserve(world.bodies.size());
+    colliders.reserve(world.colliders.size());
+
+    for (const body2D *body : world.bodies)
+    {
+        const specs::body2D spc = specs::body2D::from_instance(*body);
+        binary_snapshot::body_record &brecord = bodies.emplace_back();
+        store(spc.position, brecord.position);
+        store(spc.velocity, brecord.velocity);
+        brecord.rotation = spc.rotation;
+        brecord.angular_velocity = spc.angular_velocity;
+        brecord.type = static_cast<std::uint32_t>(spc.type);
+        brecord.first_collider = static_cast<std::uint32_t>(colliders.size());
+        brecord.collider_count = static_cast<std::uint32_t>(spc.props.colliders.size());
+        brecord.reserved = 0;
+
+        // from_instance() lists the specs in the order the body holds its colliders
+        std::size_t index = 0;
+        for (const collider2D *collider : *body)
+        {
+            const specs::collider2D &cspc = spc.props.colliders[index++];
+            binary_snapshot::collider_record &crecord = colliders.emplace_back();
+            store(cspc.position, crecord.position);
+            crecord.rotation = cspc.rotation;
+            crecord.radius = cspc.props.radius;
+            crecord.density = cspc.props.density;
+            crecord.charge = cspc.props.charge;
+            crecord.friction = cspc.props.friction;
+            crecord.restitution = cspc.props.restitution;
+            store(color(collider), crecord.color);
+            crecord.shape = static_cast<std::uint32_t>(cspc.props.shape);
+            crecord.sensor = cspc.props.is_sensor;
+            crecord.first_vertex = static_cast<std::uint32_t>(vertices.size());
+            crecord.vertex_count = 0;
+            if (cspc.props.shape == collider2D::stype::POLYGON)
+                for (const glm::vec2 &vertex : cspc.props.vertices)
+                {
+                    store(vertex, vertices.emplace_back().position);
+                    crecord.vertex_count++;
+                }
+        }
+    }
+
+    cnt.for_each_joint_table([&world](auto &table) { capture_joints(world, table); });
+}
+
+binary_snapshot::contents binary_snapshot::capture(const simulation &sim, const view_state &view)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::capture")
+    const auto lock = sim.lock_world();
+    const world2D &world = sim.world;
+
+    contents cnt;
+    app_record &app = cnt.app;
+    app = {};
+    store(view.camera_position, app.camera_position);
+    store(view.camera_scale, app.camera_scale);
+    app.camera_rotation = view.camera_rotation;
+    app.sleep_greyout = sim.sleep_greyout;
+    app.sync_speed = sim.sync_speed;
+    app.timestep = world.integrator.ts.value;
+    store(simulation::collider_color, app.collider_color);
+    store(simulation::joint_color, app.joint_color);
+    app.integrations_per_frame = sim.integrations_per_frame;
+    app.framerate = view.framerate;
+    app.paused = sim.paused;
+    app.sync_timestep = sim.sync_timestep;
+
+    const auto color = [&sim](const collider2D *collider) { return sim.color(collider); };
+    capture_world(world, color, cnt);
+    cnt.lynx_app.assign(view.lynx_app.begin(), view.lynx_app.end());
+#ifdef KIT_USE_YAML_CPP
+    store(encode_engine(world), cnt.engine);
+#endif
+    return cnt;
+}
+
+binary_snapshot::contents binary_snapshot::capture(const world2D &world)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::capture")
+    contents cnt;
+    cnt.app = {};
+    cnt.app.timestep = world.integrator.ts.value;
+    store(simulation::collider_color, cnt.app.collider_color);
+    store(simulation::joint_color, cnt.app.joint_color);
+
+    const lynx::color fallback = simulation::collider_color;
+    capture_world(world, [&fallback](const collider2D *) { return fallback; }, cnt);
+#ifdef KIT_USE_YAML_CPP
+    store(encode_engine(world), cnt.engine);
+#endif
+    return cnt;
+}
+
+// The writer only references the record arrays, which must outlive it
+static section_writer writer_for(const binary_snapshot::contents &cnt,
+                                 const std::vector<binary_snapshot::app_record> &apps)
+{
+    using section_id = binary_snapshot::section_id;
+    section_writer writer;
+    writer.add(section_id::APP, apps);
+    writer.add(section_id::BODIES, cnt.bodies);
+    writer.add(section_id::COLLIDERS, cnt.colliders);
+    writer.add(section_id::VERTICES, cnt.vertices);
+    cnt.for_each_joint_table([&writer](const auto &table) { writer.add(table.id, table.records); });
+    writer.add(section_id::LYNX_APP, cnt.lynx_app);
+    writer.add(section_id::ENGINE, cnt.engine);
+    return writer;
+}
+
+std::vector<std::byte> binary_snapshot::pack(const contents &cnt)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::pack")
+    const std::vector<app_record> apps{cnt.app};
+    return writer_for(cnt, apps).finish();
+}
+
+std::size_t binary_snapshot::packed_size(const contents &cnt)
+{
+    const std::vector<app_record> apps{cnt.app};
+    return writer_for(cnt, apps).size();
+}
+
+std::size_t binary_snapshot::estimate(const simulation &sim, const view_state &view)
+{
+    const auto lock = sim.lock_world();
+    const world2D &world = sim.world;
+
+    std::size_t vertices = 0;
+    for (const polygon_repr2D &prepr : sim.polygons())
+        vertices += prepr.mesh.mesh().vertices.size();
+
+    contents cnt;
+    std::size_t joint_bytes = 0;
+    cnt.for_each_joint_table([&world, &joint_bytes](const auto &table) {
+        using Joint = typename std::remove_cvref_t<decltype(table)>::joint_type;
+        joint_bytes += world.joints.manager<Joint>()->size() * sizeof(typename decltype(table.records)::value_type);
+    });
+
+    // One alignment pad per section at most
+    constexpr std::size_t sections = 4 + std::tuple_size_v<joint_tables> + 2;
+    return sizeof(header) + sections * (sizeof(section) + section_alignment) + sizeof(app_record) +
+           world.bodies.size() * sizeof(body_record) + world.colliders.size() * sizeof(collider_record) +
+           vertices * sizeof(vertex_record) + joint_bytes + view.lynx_app.size();
+}
+
+std::vector<std::byte> binary_snapshot::write(const simulation &sim, const view_state &view)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::write")
+    return pack(capture(sim, view));
+}
+
+bool binary_snapshot::validate(const std::span<const std::byte> data)
+{
+    header hdr;
+    if (data.size() < sizeof(hdr))
+        return false;
+    std::memcpy(&hdr, data.data(), sizeof(hdr));
+    if (std::memcmp(hdr.magic, snapshot_magic, sizeof(snapshot_magic)) != 0 || hdr.byte_order != byte_order ||
+        hdr.version != version || hdr.size != data.size())
+        return false;
+    if (sizeof(hdr) + std::uint64_t{hdr.section_count} * sizeof(section) > data.size())
+        return false;
+
+    for (std::uint32_t i = 0; i < hdr.section_count; i++)
+    {
+        section sct;
+        std::memcpy(&sct, data.data() + sizeof(hdr) + i * sizeof(section), sizeof(sct));
+        if (sct.stride == 0 || sct.offset > data.size() || sct.count > (data.size() - sct.offset) / sct.stride)
+            return false;
+        // A section this version cannot restore would be silently dropped
+        if (sct.id < section_id::APP || sct.id > section_id::ENGINE)
+            return false;
+    }
+    return true;
+}
+
+bool binary_snapshot::find(const std::span<const std::byte> data, const section_id id, const std::size_t stride,
+                           section &sct)
+{
+    header hdr;
+    std::memcpy(&hdr, data.data(), sizeof(hdr));
+    for (std::uint32_t i = 0; i < hdr.section_count; i++)
+    {
+        std::memcpy(&sct, data.data() + sizeof(hdr) + i * sizeof(section), sizeof(sct));
+        if (sct.id == id)
+            return sct.stride == stride;
+    }
+    return false;
+}
+
+static bool valid_body_type(const std::uint32_t type)
+{
+    switch (static_cast<body2D::btype>(type))
+    {
+    case body2D::btype::DYNAMIC:
+    case body2D::btype::KINEMATIC:
+    case body2D::btype::STATIC:
+        return true;
+    default:
+        return false;
+    }
+}
+static bool valid_shape(const std::uint32_t shape)
+{
+    switch (static_cast<collider2D::stype>(shape))
+    {
+    case collider2D::stype::CIRCLE:
+    case collider2D::stype::POLYGON:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool binary_snapshot::parse(const std::span<const std::byte> data, contents &cnt)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::parse")
+    if (!validate(data))
+        return false;
+
+    const std::vector<app_record> app = copy_section<app_record>(data, section_id::APP);
+    if (app.size() != 1)
+        return false;
+    cnt.app = app.front();
+    cnt.bodies = copy_section<body_record>(data, section_id::BODIES);
+    cnt.colliders = copy_section<collider_record>(data, section_id::COLLIDERS);
+    cnt.vertices = copy_section<vertex_record>(data, section_id::VERTICES);
+    cnt.lynx_app = copy_section<char>(data, section_id::LYNX_APP);
+    cnt.engine = copy_section<char>(data, section_id::ENGINE);
+
+    // A missing joint section or an unexpected stride means another build's joint layouts
+    bool joints_valid = true;
+    cnt.for_each_joint_table([&data, &joints_valid](auto &table) {
+        using record = typename decltype(table.records)::value_type;
+        section sct;
+        if (find(data, table.id, sizeof(record), sct))
+            table.records = copy_section<record>(data, table.id);
+        else
+            joints_valid = false;
+    });
+    if (!joints_valid)
+        return false;
+
+    // Checked before touching the world, so that a corrupt file cannot leave it half loaded
+    for (const body_record &brecord : cnt.bodies)
+        if (!valid_body_type(brecord.type) ||
+            std::uint64_t{brecord.first_collider} + brecord.collider_count > cnt.colliders.size())
+            return false;
+    for (const collider_record &crecord : cnt.colliders)
+    {
+        if (!valid_shape(crecord.shape) ||
+            std::uint64_t{crecord.first_vertex} + crecord.vertex_count > cnt.vertices.size())
+            return false;
+        if (static_cast<collider2D::stype>(crecord.shape) == collider2D::stype::POLYGON && crecord.vertex_count < 3)
+            return false;
+    }
+    cnt.for_each_joint_table([&cnt, &joints_valid](const auto &table) {
+        for (const auto &record : table.records)
+            if (record.joint.body1 >= cnt.bodies.size() || record.joint.body2 >= cnt.bodies.size())
+                joints_valid = false;
+    });
+    if (!joints_valid)
+        return false;
+
+#ifdef KIT_USE_YAML_CPP
+    if (cnt.engine.empty())
+        return true;
+    try
+    {
+        return YAML::Load(std::string(cnt.engine.begin(), cnt.engine.end())).IsMap();
+    }
+    catch (const YAML::Exception &)
+    {
+        return false;
+    }
+#else
+    // The engine settings cannot be restored without YAML support
+    return cnt.engine.empty();
+#endif
+}
+
+void binary_snapshot::begin_insertion(const contents &cnt, simulation &sim, view_state &view)
+{
+    const app_record &arecord = cnt.app;
+    view.camera_position = load_vec2(arecord.camera_position);
+    view.camera_scale = load_vec2(arecord.camera_scale);
+    view.camera_rotation = arecord.camera_rotation;
+    view.framerate = arecord.framerate;
+    view.lynx_app.assign(cnt.lynx_app.begin(), cnt.lynx_app.end());
+
+    world2D &world = sim.world;
+    world.bodies.clear();
+
+    simulation::collider_color = load_color(arecord.collider_color);
+    simulation::joint_color = load_color(arecord.joint_color);
+    sim.sleep_greyout = arecord.sleep_greyout;
+    sim.sync_speed = arecord.sync_speed;
+    sim.integrations_per_frame = arecord.integrations_per_frame;
+    sim.paused = arecord.paused != 0;
+    sim.sync_timestep = arecord.sync_timestep != 0;
+    world.integrator.ts.value = arecord.timestep;
+}
+
+static specs::body2D load_body(const binary_snapshot::contents &cnt, const binary_snapshot::body_record &brecord)
+{
+    specs::body2D spc;
+    spc.position = load_vec2(brecord.position);
+    spc.velocity = load_vec2(brecord.velocity);
+    spc.rotation = brecord.rotation;
+    spc.angular_velocity = brecord.angular_velocity;
+    spc.type = static_cast<body2D::btype>(brecord.type);
+    spc.props.colliders.reserve(brecord.collider_count);
+    for (std::uint32_t j = 0; j < brecord.collider_count; j++)
+    {
+        const binary_snapshot::collider_record &crecord = cnt.colliders[brecord.first_collider + j];
+        specs::collider2D &cspc = spc.props.colliders.emplace_back();
+        cspc.position = load_vec2(crecord.position);
+        cspc.rotation = crecord.rotation;
+        cspc.props.radius = crecord.radius;
+        cspc.props.density = crecord.density;
+        cspc.props.charge = crecord.charge;
+        cspc.props.friction = crecord.friction;
+        cspc.props.restitution = crecord.restitution;
+        cspc.props.shape = static_cast<collider2D::stype>(crecord.shape);
+        cspc.props.is_sensor = crecord.sensor != 0;
+        if (cspc.props.shape == collider2D::stype::POLYGON)
+        {
+            cspc.props.vertices.clear();
+            for (std::uint32_t k = 0; k < crecord.vertex_count; k++)
+                cspc.props.vertices.push_back(load_vec2(cnt.vertices[crecord.first_vertex + k].position));
+        }
+    }
+    return spc;
+}
+
+void binary_snapshot::insert_bodies(const contents &cnt, simulation &sim, const std::size_t first,
+                                    const std::size_t last)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::insert_bodies")
+    world2D &world = sim.world;
+
+    std::size_t expected_colliders = 0;
+    for (std::size_t i = first; i < last; i++)
+        expected_colliders += cnt.bodies[i].collider_count;
+
+    {
+        const simulation::batch_guard guard{sim, expected_colliders};
+        for (std::size_t i = first; i < last; i++)
+            world.bodies.add(load_body(cnt, cnt.bodies[i]));
+    }
+
+    // Bodies are appended and list their colliders in the order of their specs
+    const std::size_t first_body = world.bodies.size() - (last - first);
+    for (std::size_t i = first; i < last; i++)
+    {
+        const body_record &brecord = cnt.bodies[i];
+        std::uint32_t index = 0;
+        for (const collider2D *collider : *world.bodies[first_body + i - first])
+            if (index < brecord.collider_count)
+                sim.color(collider, load_color(cnt.colliders[brecord.first_collider + index++].color));
+    }
+}
+
+void binary_snapshot::insert_joints(const contents &cnt, world2D &world, const std::size_t first,
+                                    const std::size_t last)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::insert_joints")
+    std::size_t offset = 0;
+    cnt.for_each_joint_table([&world, first, last, &offset](const auto &table) {
+        const std::size_t begin = std::max(first, offset);
+        const std::size_t end = std::min(last, offset + table.records.size());
+        for (std::size_t i = begin; i < end; i++)
+            add_joint(world, table.records[i - offset]);
+        offset += table.records.size();
+    });
+}
+
+void binary_snapshot::finish_insertion(const contents &cnt, world2D &world)
+{
+#ifdef KIT_USE_YAML_CPP
+    if (cnt.engine.empty())
+        return;
+    const YAML::Node node = YAML::Load(std::string(cnt.engine.begin(), cnt.engine.end()));
+    decode_setting(node, "Integrator", world.integrator);
+    decode_setting(node, "Behaviours", world.behaviours);
+    decode_setting(node, "Collisions", world.collisions);
+    decode_setting(node, "Islands", world.islands);
+#endif
+}
+
+void binary_snapshot::insert(const contents &cnt, world2D &world)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::insert")
+    world.bodies.clear();
+    world.integrator.ts.value = cnt.app.timestep;
+    for (const body_record &brecord : cnt.bodies)
+        world.bodies.add(load_body(cnt, brecord));
+    insert_joints(cnt, world, 0, cnt.joint_count());
+    finish_insertion(cnt, world);
+}
+
+bool binary_snapshot::read(const std::span<const std::byte> data, world2D &world)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::read")
+    contents cnt;
+    if (!parse(data, cnt))
+        return false;
+    insert(cnt, world);
+    return true;
+}
+
+bool binary_snapshot::read(const std::span<const std::byte> data, simulation &sim, view_state &view)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::read")
+    contents cnt;
+    if (!parse(data, cnt))
+        return false;
+
+    const auto lock = sim.lock_world();
+    begin_insertion(cnt, sim, view);
+    insert_bodies(cnt, sim, 0, cnt.bodies.size());
+    insert_joints(cnt, sim.world, 0, cnt.joint_count());
+    finish_insertion(cnt, sim.world);
+    return true;
+}
+
+bool binary_snapshot::save(const std::filesystem::path &path, const std::span<const std::byte> data)
+{
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file)
+        return false;
+    file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool binary_snapshot::load(const std::filesystem::path &path, std::vector<std::byte> &data)
+{
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+    if (!file)
+        return false;
+    const std::streamsize size = file.tellg();
+    if (size < 0)
+        return false;
+    data.resize(static_cast<std::size_t>(size));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(data.data()), size);
+    return static_cast<bool>(file);
+}
+
+#ifdef KIT_USE_YAML_CPP
+bool binary_snapshot::parse(const YAML::Node &node, contents &cnt)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::parse")
+    if (!node.IsMap() || node.size() < 12)
+        return false;
+
+    // The engine decodes into a world of its own, so that parsing touches no simulation and can run on any thread
+    world2D world{specs::world2D{}};
+    world.add_builtin_joint_managers();
+    node["Engine"].as<world2D>(world);
+
+    const lynx::color collider_color = node["Collider color"].as<lynx::color>();
+    const YAML::Node colors = node["Shape colors"];
+    const auto color = [&colors, &collider_color](const collider2D *collider) {
+        return colors ? colors[collider->meta.index].as<lynx::color>() : collider_color;
+    };
+    capture_world(world, color, cnt);
+
+    // Behaviours are added by the app before decoding and only have their state decoded, so the standalone world has
+    // none and they are carried over from the node as they are
+    YAML::Node engine = encode_engine(world);
+    if (const YAML::Node behaviours = node["Engine"]["Behaviours"])
+        engine["Behaviours"] = behaviours;
+    store(engine, cnt.engine);
+
+    app_record &app = cnt.app;
+    app = {};
+    store(node["Camera position"].as<glm::vec2>(), app.camera_position);
+    store(node["Camera scale"].as<glm::vec2>(), app.camera_scale);
+    app.camera_rotation = node["Camera rotation"].as<float>();
+    app.sleep_greyout = node["Sleep greyout"].as<float>();
+    app.sync_speed = node["Sync speed"].as<float>();
+    app.timestep = world.integrator.ts.value;
+    store(collider_color, app.collider_color);
+    store(node["Joints color"].as<lynx::color>(), app.joint_color);
+    app.integrations_per_frame = node["Integrations per frame"].as<std::uint32_t>();
+    app.framerate = node["Framerate"].as<std::uint32_t>();
+    app.paused = node["Paused"].as<bool>();
+    app.sync_timestep = node["Sync timestep"].as<bool>();
+
+    cnt.lynx_app.clear();
+    if (const YAML::Node lynx_app = node["Lynx app"])
+        store(lynx_app, cnt.lynx_app);
+    return true;
+}
+
+bool binary_snapshot::from_yaml(const YAML::Node &node, std::vector<std::byte> &data)
+{
+    contents cnt;
+    if (!parse(node, cnt))
+        return false;
+    data = pack(cnt);
+    return true;
+}
+
+YAML::Node binary_snapshot::to_yaml(const std::span<const std::byte> data)
+{
+    contents cnt;
+    return parse(data, cnt) ? to_yaml(cnt) : YAML::Node{};
+}
+
+YAML::Node binary_snapshot::to_yaml(const contents &cnt)
+{
+    KIT_PERF_SCOPE("ppx::binary_snapshot::to_yaml")
+    // Like parse(), the engine goes through a world of its own
+    world2D world{specs::world2D{}};
+    world.add_builtin_joint_managers();
+    insert(cnt, world);
+
+    // Same layout as kit::yaml::codec<ppx::app>::encode()
+    YAML::Node node;
+    const std::string lynx_app(cnt.lynx_app.begin(), cnt.lynx_app.end());
+    node["Lynx app"] = lynx_app.empty() ? YAML::Node{} : YAML::Load(lynx_app);
+    node["Engine"] = world;
+    // The standalone world has no behaviours to decode into, so they are carried over as stored
+    if (!cnt.engine.empty())
+        if (const YAML::Node behaviours = YAML::Load(std::string(cnt.engine.begin(), cnt.engine.end()))["Behaviours"])
+            node["Engine"]["Behaviours"] = behaviours;
+
+    // Bodies list their colliders in the order their records do
+    for (std::size_t i = 0; i < world.bodies.size(); i++)
+    {
+        std::uint32_t index = cnt.bodies[i].first_collider;
+        for (const collider2D *collider : *world.bodies[i])
+            node["Shape colors"][collider->meta.index] = load_color(cnt.colliders[index++].color);
+    }
+
+    const app_record &app = cnt.app;
+    node["Sleep greyout"] = app.sleep_greyout;
+    node["Paused"] = app.paused != 0;
+    node["Sync timestep"] = app.sync_timestep != 0;
+    node["Sync speed"] = app.sync_speed;
+    node["Collider color"] = load_color(app.collider_color);
+    node["Joints color"] = load_color(app.joint_color);
+    node["Integrations per frame"] = app.integrations_per_frame;
+    node["Framerate"] = app.framerate;
+    node["Camera position"] = load_vec2(app.camera_position);
+    node["Camera scale"] = load_vec2(app.camera_scale);
+    node["Camera rotation"] = app.camera_rotation;
+    return node;
+}
+#endif
+} // namespace ppx
@@ -0,0 +1,185 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/serialization/scene_loader.hpp"
+
+namespace ppx
+{
+scene_loader::~scene_loader()
+{
+    m_cancelled = true;
+    join();
+}
+
+bool scene_loader::load(const std::filesystem::path &path)
+{
+    if (loading())
+        return false;
+    join();
+
+    m_path = path;
+    m_error.clear();
+    m_contents = {};
+    m_view = {};
+    m_bodies = 0;
+    m_joints = 0;
+    m_total = 0;
+    m_parsed = false;
+    m_cancelled = false;
+    m_status = status::PARSING;
+    m_thread = std::thread(&scene_loader::parse, this, path);
+    return true;
+}
+
+void scene_loader::parse(const std::filesystem::path path)
+{
+    KIT_PERF_SCOPE("ppx::scene_loader::parse")
+#ifdef KIT_USE_YAML_CPP
+    const std::filesystem::path extension = path.extension();
+    if (extension == ".yaml" || extension == ".yml")
+    {
+        // Exceptions cannot leave the loading thread, so YAML errors are reported like any other parsing failure
+        try
+        {
+            const YAML::Node node = YAML::LoadFile(path.string());
+            if (!m_cancelled && !binary_snapshot::parse(node, m_contents))
+                m_error = "'" + path.string() + "' is not a valid scene";
+        }
+        catch (const YAML::Exception &e)
+        {
+            m_error = "Failed to parse '" + path.string() + "': " + e.what();
+        }
+        m_parsed = true;
+        return;
+    }
+#endif
+    std::vector<std::byte> data;
+    if (!binary_snapshot::load(path, data))
+        m_error = "Failed to read '" + path.string() + "'";
+    else if (!m_cancelled && !binary_snapshot::parse(data, m_contents))
+        m_error = "'" + path.string() + "' is not a valid snapshot of a supported version";
+    m_parsed = true;
+}
+
+bool scene_loader::update(simulation &sim, binary_snapshot::view_state &view)
+{
+    if (m_status == status::PARSING)
+    {
+        if (!m_parsed)
+            return false;
+        join();
+        if (m_cancelled)
+        {
+            finish(status::CANCELLED);
+            return false;
+        }
+        if (!m_error.empty())
+        {
+            KIT_ERROR("Scene load failed: {0}", m_error);
+            finish(status::FAILED);
+            return false;
+        }
+
+        const auto lock = sim.lock_world();
+        binary_snapshot::begin_insertion(m_contents, sim, m_view);
+        m_paused = sim.paused;
+        sim.paused = true;
+        m_total = m_contents.bodies.size() + m_contents.joint_count();
+        m_status = status::INSERTING;
+    }
+    if (m_status != status::INSERTING)
+        return false;
+
+    KIT_PERF_SCOPE("ppx::scene_loader::update")
+    PPX_PROFILE_SCOPE("ppx::scene_loader::update")
+    const auto lock = sim.lock_world();
+    if (m_cancelled)
+    {
+        sim.world.bodies.clear();
+        sim.paused = m_paused;
+        finish(status::CANCELLED);
+        return false;
+    }
+
+    // Bodies are inserted by record index, which only holds if nothing else added or removed any
+    if (sim.world.bodies.size() != m_bodies)
+    {
+        m_error = "The world was modified while loading '" + m_path.string() + "'";
+        KIT_ERROR("Scene load failed: {0}", m_error);
+        sim.paused = m_paused;
+        finish(status::FAILED);
+        return false;
+    }
+
+    const kit::perf::clock insert_clock;
+    const std::size_t bodies = m_contents.bodies.size();
+    const std::size_t joints = m_contents.joint_count();
+    const std::size_t chunk = std::max<std::size_t>(grain, 1);
+    do
+    {
+        if (m_bodies < bodies)
+        {
+            const std::size_t last = std::min(m_bodies + chunk, bodies);
+            binary_snapshot::insert_bodies(m_contents, sim, m_bodies, last);
+            m_bodies = last;
+        }
+        else
+        {
+            const std::size_t last = std::min(m_joints + chunk, joints);
+            binary_snapshot::insert_joints(m_contents, sim.world, m_joints, last);
+            m_joints = last;
+        }
+    } while (m_bodies + m_joints < m_total && insert_clock.elapsed().as<kit::perf::time::seconds, float>() < budget);
+
+    if (m_bodies + m_joints < m_total)
+        return false;
+    binary_snapshot::finish_insertion(m_contents, sim.world);
+    sim.paused = m_paused;
+    view = m_view;
+    finish(status::FINISHED);
+    return true;
+}
+
+void scene_loader::cancel()
+{
+    if (loading())
+        m_cancelled = true;
+}
+
+void scene_loader::finish(const status result)
+{
+    m_contents = {};
+    m_status = result;
+}
+
+void scene_loader::join()
+{
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+scene_loader::status scene_loader::state() const
+{
+    return m_status;
+}
+bool scene_loader::loading() const
+{
+    return m_status == status::PARSING || m_status == status::INSERTING;
+}
+
+float scene_loader::progress() const
+{
+    if (m_status == status::FINISHED)
+        return 1.f;
+    if (m_total == 0)
+        return 0.f;
+    return static_cast<float>(m_bodies + m_joints) / static_cast<float>(m_total);
+}
+
+const std::filesystem::path &scene_loader::path() const
+{
+    return m_path;
+}
+const std::string &scene_loader::error() const
+{
+    return m_error;
+}
+} // namespace ppx
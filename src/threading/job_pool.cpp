@@ -0,0 +1,104 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/threading/job_pool.hpp"
+
+namespace ppx
+{
+job_pool::job_pool(const std::size_t thread_count)
+{
+    // The caller thread always works too, so a queue is needed for it even if there are no workers
+    m_queues.reserve(thread_count + 1);
+    for (std::size_t i = 0; i < thread_count + 1; i++)
+        m_queues.push_back(kit::make_scope<worker_queue>());
+
+    m_threads.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; i++)
+        m_threads.emplace_back(&job_pool::worker_loop, this, i + 1);
+}
+
+job_pool::~job_pool()
+{
+    {
+        std::scoped_lock lock(m_sleep_mutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+    for (std::thread &thread : m_threads)
+        thread.join();
+}
+
+std::size_t job_pool::default_thread_count()
+{
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+void job_pool::submit(job jb)
+{
+    const std::size_t index = m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    {
+        std::scoped_lock lock(m_queues[index]->mutex);
+        m_queues[index]->jobs.push_back(std::move(jb));
+    }
+    {
+        std::scoped_lock lock(m_sleep_mutex);
+        m_pending.fetch_add(1, std::memory_order_release);
+    }
+    m_wake.notify_one();
+}
+
+bool job_pool::try_run_one(const std::size_t preferred)
+{
+    job jb;
+    for (std::size_t i = 0; i < m_queues.size() && !jb; i++)
+    {
+        const bool own = i == 0;
+        worker_queue &queue = *m_queues[(preferred + i) % m_queues.size()];
+
+        std::scoped_lock lock(queue.mutex);
+        if (queue.jobs.empty())
+            continue;
+        if (own)
+        {
+            jb = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        }
+        else
+        {
+            jb = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+    }
+    if (!jb)
+        return false;
+
+    m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    jb();
+    return true;
+}
+
+void job_pool::wait(const std::atomic<std::size_t> &remaining)
+{
+    while (remaining.load(std::memory_order_acquire) > 0)
+        if (!try_run_one(0))
+            std::this_thread::yield();
+}
+
+void job_pool::worker_loop(const std::size_t index)
+{
+    for (;;)
+    {
+        if (try_run_one(index))
+            continue;
+
+        std::unique_lock lock(m_sleep_mutex);
+        m_wake.wait(lock, [this]() { return !m_running || m_pending.load(std::memory_order_acquire) > 0; });
+        if (!m_running)
+            return;
+    }
+}
+
+std::size_t job_pool::thread_count() const
+{
+    return m_threads.size();
+}
+} // namespace ppx
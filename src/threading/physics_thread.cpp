@@ -0,0 +1,126 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/threading/physics_thread.hpp"
+
+namespace ppx
+{
+physics_thread::physics_thread(world2D &world, const float rate) : m_world(world), m_rate(rate)
+{
+    KIT_ASSERT_ERROR(rate > 0.f, "Physics rate must be positive");
+}
+
+physics_thread::~physics_thread()
+{
+    stop();
+}
+
+void physics_thread::start()
+{
+    if (m_running)
+        return;
+    {
+        const auto lock = lock_world();
+        m_world.integrator.ts.value = 1.f / m_rate;
+        publish();
+    }
+    m_running = true;
+    m_thread = std::thread(&physics_thread::run, this);
+}
+
+void physics_thread::stop()
+{
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+bool physics_thread::running() const
+{
+    return m_running;
+}
+
+void physics_thread::request_step()
+{
+    m_requested_steps.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::unique_lock<std::mutex> physics_thread::lock_world()
+{
+    return std::unique_lock<std::mutex>(m_world_mutex);
+}
+
+void physics_thread::run()
+{
+    using clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(1.f / m_rate));
+
+    auto next_tick = clock::now();
+    while (m_running)
+    {
+        next_tick += period;
+        {
+            const auto lock = lock_world();
+            const kit::perf::clock step_clock;
+
+            const bool single_step = m_requested_steps.load(std::memory_order_relaxed) > 0;
+            const bool step = !paused || single_step;
+            if (step)
+            {
+                m_world.step();
+                if (single_step)
+                    m_requested_steps.fetch_sub(1, std::memory_order_relaxed);
+            }
+            const kit::perf::time step_time = step_clock.elapsed();
+            m_step_time.store(step_time, std::memory_order_relaxed);
+            if (step && on_step)
+                on_step(step_time);
+            publish();
+        }
+
+        // If the world cannot keep up, drop the missed ticks instead of trying to catch up with them
+        const auto now = clock::now();
+        if (next_tick < now)
+            next_tick = now;
+        else
+            std::this_thread::sleep_until(next_tick);
+    }
+}
+
+void physics_thread::publish()
+{
+    m_snapshots.back().capture(m_world);
+    m_snapshots.publish();
+}
+
+bool physics_thread::consume(world_snapshot &previous, world_snapshot &current)
+{
+    if (!m_snapshots.consume())
+        return false;
+    std::swap(previous, current);
+    current = m_snapshots.front();
+    return true;
+}
+
+float physics_thread::interpolation(const world_snapshot &current) const
+{
+    // Rendering lags one tick behind, blending from the previous snapshot towards the current one as time goes by
+    const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - current.published;
+    return std::clamp(elapsed.count() * m_rate, 0.f, 1.f);
+}
+
+float physics_thread::rate() const
+{
+    return m_rate;
+}
+kit::perf::time physics_thread::step_time() const
+{
+    return m_step_time.load(std::memory_order_relaxed);
+}
+
+std::size_t physics_thread::memory() const
+{
+    std::size_t bytes = 0;
+    for (const world_snapshot &snapshot : m_snapshots.buffers())
+        bytes += snapshot.memory();
+    return bytes;
+}
+} // namespace ppx
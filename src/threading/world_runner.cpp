@@ -0,0 +1,148 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/threading/world_runner.hpp"
+#include "ppx-app/profiling/frame_profiler.hpp"
+#include "ppx-app/serialization/binary_snapshot.hpp"
+
+#include <fstream>
+
+namespace ppx
+{
+// Quotes a CSV field, doubling the quotes it contains
+static std::string csv_field(const std::string &text)
+{
+    std::string field = "\"";
+    for (const char c : text)
+    {
+        if (c == '"')
+            field += '"';
+        field += c;
+    }
+    return field + '"';
+}
+
+world_runner::instance::instance(const ppx::specs::world2D &spc, const std::string &label) : world(spc), label(label)
+{
+    world.add_builtin_joint_managers();
+}
+
+world2D &world_runner::add(const ppx::specs::world2D &spc, const std::string &label)
+{
+    return m_instances.emplace_back(kit::make_scope<instance>(spc, label))->world;
+}
+
+world2D &world_runner::add(const world2D &source, const std::string &label)
+{
+    const binary_snapshot::contents cnt = binary_snapshot::capture(source);
+    world2D &world = add(ppx::specs::world2D{}, label);
+    binary_snapshot::insert(cnt, world);
+    return world;
+}
+
+world2D *world_runner::load(const std::filesystem::path &path, const std::string &label)
+{
+    std::vector<std::byte> data;
+    binary_snapshot::contents cnt;
+    if (!binary_snapshot::load(path, data) || !binary_snapshot::parse(data, cnt))
+        return nullptr;
+    world2D &world = add(ppx::specs::world2D{}, label);
+    binary_snapshot::insert(cnt, world);
+    return &world;
+}
+
+void world_runner::remove(const std::size_t index)
+{
+    KIT_ASSERT_ERROR(index < m_instances.size(), "World index {0} is out of bounds", index);
+    m_instances.erase(m_instances.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+void world_runner::clear()
+{
+    m_instances.clear();
+}
+
+void world_runner::step(job_pool &jobs)
+{
+    if (!paused)
+        run(jobs, steps_per_update);
+}
+
+void world_runner::run(job_pool &jobs, const std::uint64_t steps)
+{
+    KIT_PERF_SCOPE("ppx::world_runner::run")
+    PPX_PROFILE_SCOPE("ppx::world_runner::run")
+    if (m_instances.empty() || steps == 0)
+        return;
+
+    const kit::perf::clock wall_clock;
+    jobs.for_each(
+        m_instances,
+        [&jobs, steps](kit::scope<instance> &inst) {
+            for (std::uint64_t i = 0; i < steps; i++)
+            {
+                const kit::perf::clock step_clock;
+                inst->world.step();
+                inst->step_time = step_clock.elapsed();
+                inst->steps++;
+                inst->simulated_time += inst->world.integrator.ts.value;
+                inst->telemetry.sample(inst->world, jobs, inst->step_time);
+            }
+        },
+        1);
+
+    m_stats.wall_time = wall_clock.elapsed();
+    const float seconds = m_stats.wall_time.as<kit::perf::time::seconds, float>();
+    m_stats.steps_per_second = seconds > 0.f ? static_cast<float>(steps * m_instances.size()) / seconds : 0.f;
+}
+
+world_runner::instance &world_runner::operator[](const std::size_t index)
+{
+    KIT_ASSERT_ERROR(index < m_instances.size(), "World index {0} is out of bounds", index);
+    return *m_instances[index];
+}
+const world_runner::instance &world_runner::operator[](const std::size_t index) const
+{
+    KIT_ASSERT_ERROR(index < m_instances.size(), "World index {0} is out of bounds", index);
+    return *m_instances[index];
+}
+
+std::size_t world_runner::size() const
+{
+    return m_instances.size();
+}
+bool world_runner::empty() const
+{
+    return m_instances.empty();
+}
+
+const world_runner::stats &world_runner::statistics() const
+{
+    return m_stats;
+}
+
+bool world_runner::write_csv(const std::filesystem::path &path) const
+{
+    std::ofstream file{path, std::ios::trunc};
+    if (!file)
+        return false;
+
+    file << "index,label,steps,simulated_time,last_step_ms,bodies,sleeping_bodies,colliders,kinetic_energy\n";
+    std::vector<telemetry_sample> samples;
+    for (std::size_t i = 0; i < m_instances.size(); i++)
+    {
+        const instance &inst = *m_instances[i];
+        inst.telemetry.read(samples);
+        const telemetry_sample last = samples.empty() ? telemetry_sample{} : samples.back();
+
+        // Labels are quoted, as sweep labels usually list parameters separated by commas
+        file << i << ',' << csv_field(inst.label) << ',' << inst.steps << ',' << inst.simulated_time << ','
+             << 1000.f * inst.step_time.as<kit::perf::time::seconds, float>() << ',' << inst.world.bodies.size() << ','
+             << last.sleeping_bodies << ',' << inst.world.colliders.size() << ',' << last.kinetic_energy << '\n';
+
+        std::filesystem::path telemetry_path = path;
+        telemetry_path.replace_filename(path.stem().string() + "_" + std::to_string(i) + ".csv");
+        if (!inst.telemetry.write_csv(telemetry_path))
+            return false;
+    }
+    return static_cast<bool>(file);
+}
+} // namespace ppx
@@ -0,0 +1,101 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/threading/world_snapshot.hpp"
+#include "ppx/world.hpp"
+#include "ppx/joints/spring_joint.hpp"
+#include "ppx/joints/distance_joint.hpp"
+#include "ppx/joints/prismatic_joint.hpp"
+#include "ppx/joints/revolute_joint.hpp"
+#include "ppx/joints/weld_joint.hpp"
+#include "ppx/joints/rotor_joint.hpp"
+#include "ppx/joints/motor_joint.hpp"
+#include "ppx/joints/ball_joint.hpp"
+
+namespace ppx
+{
+collider_state collider_state::from(const collider2D *collider)
+{
+    const glm::mat3 transform = collider->ltransform().ftransform();
+    return {collider, glm::vec2(transform[2]), atan2f(transform[0][1], transform[0][0]), collider->body()->asleep(),
+            bounds_of(collider)};
+}
+
+bounds2D collider_state::bounds_of(const collider2D *collider)
+{
+    const aabb2D &bbox = collider->bounding_box();
+    return {bbox.min, bbox.max};
+}
+
+collider_state collider_state::lerp(const collider_state &from, const collider_state &to, const float alpha)
+{
+    float drot = to.rotation - from.rotation;
+    if (drot > glm::pi<float>())
+        drot -= 2.f * glm::pi<float>();
+    else if (drot < -glm::pi<float>())
+        drot += 2.f * glm::pi<float>();
+    return {to.collider,
+            glm::mix(from.position, to.position, alpha),
+            from.rotation + alpha * drot,
+            to.asleep,
+            {glm::min(from.bounds.min, to.bounds.min), glm::max(from.bounds.max, to.bounds.max)}};
+}
+
+glm::mat3 collider_state::transform() const
+{
+    const float c = cosf(rotation), s = sinf(rotation);
+    return glm::mat3{glm::vec3(c, s, 0.f), glm::vec3(-s, c, 0.f), glm::vec3(position, 1.f)};
+}
+
+joint_state joint_state::lerp(const joint_state &from, const joint_state &to, const float alpha)
+{
+    return {to.joint, glm::mix(from.anchor1, to.anchor1, alpha), glm::mix(from.anchor2, to.anchor2, alpha),
+            glm::mix(from.value, to.value, alpha), to.asleep};
+}
+
+template <typename Joint> static void fill_joint_states(world2D &world, std::vector<joint_state> &states)
+{
+    const auto *manager = world.joints.manager<Joint>();
+    states.resize(manager->size());
+    for (const Joint *joint : *manager)
+    {
+        joint_state &state = states[joint->meta.index];
+        state.joint = joint;
+        state.anchor1 = joint->ganchor1();
+        state.anchor2 = joint->ganchor2();
+        state.asleep = joint->asleep();
+        if constexpr (std::is_same_v<Joint, distance_joint2D>)
+            state.value = joint->constraint_position();
+    }
+}
+
+void world_snapshot::capture(world2D &world)
+{
+    colliders.resize(world.colliders.size());
+    for (const collider2D *collider : world.colliders)
+        colliders[collider->meta.index] = collider_state::from(collider);
+
+    fill_joint_states<spring_joint2D>(world, springs);
+    fill_joint_states<distance_joint2D>(world, distances);
+    fill_joint_states<prismatic_joint2D>(world, prismatics);
+    fill_joint_states<revolute_joint2D>(world, revolutes);
+    fill_joint_states<weld_joint2D>(world, welds);
+    fill_joint_states<rotor_joint2D>(world, rotors);
+    fill_joint_states<motor_joint2D>(world, motors);
+    fill_joint_states<ball_joint2D>(world, balls);
+    published = std::chrono::steady_clock::now();
+}
+
+void world_snapshot::clear()
+{
+    colliders.clear();
+    for (const auto states : snapshot_joint_states)
+        (this->*states).clear();
+}
+
+std::size_t world_snapshot::memory() const
+{
+    std::size_t bytes = colliders.capacity() * sizeof(collider_state);
+    for (const auto states : snapshot_joint_states)
+        bytes += (this->*states).capacity() * sizeof(joint_state);
+    return bytes;
+}
+} // namespace ppx
@@ -0,0 +1,114 @@
+#include "ppx-app/internal/pch.hpp"
+#include "ppx-app/utility/spatial_grid.hpp"
+
+namespace ppx
+{
+void spatial_grid2D::clear()
+{
+    m_entries.clear();
+    m_sorted.clear();
+    m_oversized.clear();
+    m_cell_offsets.clear();
+    m_columns = 0;
+    m_rows = 0;
+}
+
+void spatial_grid2D::reserve(const std::size_t capacity)
+{
+    m_entries.reserve(capacity);
+    m_sorted.reserve(capacity);
+    m_cell_indices.reserve(capacity);
+}
+
+void spatial_grid2D::insert(const std::size_t id, const bounds2D &bounds)
+{
+    m_entries.push_back({id, bounds});
+}
+
+void spatial_grid2D::build(float cell_size)
+{
+    m_sorted.clear();
+    m_oversized.clear();
+    if (m_entries.empty())
+        return;
+
+    m_area = m_entries.front().bounds;
+    float average_extent = 0.f;
+    for (const entry &e : m_entries)
+    {
+        m_area.enclose(e.bounds.min);
+        m_area.enclose(e.bounds.max);
+        const glm::vec2 dim = e.bounds.dimension();
+        average_extent += std::max(dim.x, dim.y);
+    }
+    average_extent /= static_cast<float>(m_entries.size());
+    if (cell_size <= 0.f)
+        cell_size = std::max(2.f * average_extent, 1e-3f);
+
+    // Keep the cell count proportional to the entry count so that sparse worlds do not allocate huge grids
+    const glm::vec2 dim = m_area.dimension();
+    const float max_cells = 4.f * static_cast<float>(m_entries.size()) + 16.f;
+    while ((dim.x / cell_size + 1.f) * (dim.y / cell_size + 1.f) > max_cells)
+        cell_size *= 2.f;
+
+    m_cell_size = cell_size;
+    m_columns = static_cast<std::uint32_t>(dim.x / cell_size) + 1;
+    m_rows = static_cast<std::uint32_t>(dim.y / cell_size) + 1;
+    m_cell_offsets.assign(static_cast<std::size_t>(m_columns) * m_rows + 1, 0);
+    m_cell_indices.resize(m_entries.size());
+
+    m_margin = 0.f;
+    for (std::size_t i = 0; i < m_entries.size(); i++)
+    {
+        const entry &e = m_entries[i];
+        const glm::vec2 half_extent = 0.5f * e.bounds.dimension();
+        if (std::max(half_extent.x, half_extent.y) > cell_size)
+        {
+            m_oversized.push_back(e);
+            m_cell_indices[i] = UINT32_MAX;
+            continue;
+        }
+        m_margin = std::max(m_margin, std::max(half_extent.x, half_extent.y));
+
+        const glm::ivec2 c = cell(e.bounds.center());
+        m_cell_indices[i] = static_cast<std::uint32_t>(c.y) * m_columns + static_cast<std::uint32_t>(c.x);
+        m_cell_offsets[m_cell_indices[i] + 1]++;
+    }
+
+    for (std::size_t c = 1; c < m_cell_offsets.size(); c++)
+        m_cell_offsets[c] += m_cell_offsets[c - 1];
+
+    m_sorted.resize(m_entries.size() - m_oversized.size());
+    std::vector<std::uint32_t> cursor(m_cell_offsets.begin(), m_cell_offsets.end() - 1);
+    for (std::size_t i = 0; i < m_entries.size(); i++)
+        if (m_cell_indices[i] != UINT32_MAX)
+            m_sorted[cursor[m_cell_indices[i]]++] = m_entries[i];
+    m_entries.clear();
+}
+
+glm::ivec2 spatial_grid2D::cell(const glm::vec2 &point) const
+{
+    // Clamped before converting, as points far outside the grid do not fit in an int
+    const glm::vec2 local = (point - m_area.min) / m_cell_size;
+    const glm::vec2 last{static_cast<float>(m_columns - 1), static_cast<float>(m_rows - 1)};
+    return glm::ivec2(glm::clamp(glm::floor(local), glm::vec2(0.f), last));
+}
+
+std::size_t spatial_grid2D::size() const
+{
+    return m_sorted.size() + m_oversized.size();
+}
+std::size_t spatial_grid2D::oversized() const
+{
+    return m_oversized.size();
+}
+float spatial_grid2D::cell_size() const
+{
+    return m_cell_size;
+}
+std::size_t spatial_grid2D::memory() const
+{
+    return (m_entries.capacity() + m_sorted.capacity() + m_oversized.capacity()) * sizeof(entry) +
+           (m_cell_offsets.capacity() + m_cell_indices.capacity()) * sizeof(std::uint32_t);
+}
+} // namespace ppx
@@ -0,0 +1,207 @@
+#include "test.hpp"
+
+#include "ppx-app/serialization/binary_snapshot.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace ppx::test
+{
+static simulation::specs test_specs()
+{
+    simulation::specs spc;
+    spc.worker_threads = 1;
+    return spc;
+}
+
+static body2D *add_body(world2D &world, const glm::vec2 &position, const body2D::btype type, const bool circle)
+{
+    specs::collider2D collider;
+    if (circle)
+    {
+        collider.props.shape = collider2D::stype::CIRCLE;
+        collider.props.radius = 0.75f;
+    }
+    else
+        collider.props.vertices = polygon::rect(1.5f, 1.f);
+    collider.props.friction = 0.3f;
+    collider.props.restitution = 0.1f;
+
+    specs::body2D body;
+    body.position = position;
+    body.velocity = {position.y, -position.x};
+    body.rotation = 0.25f * position.x;
+    body.type = type;
+    body.props.colliders.push_back(collider);
+    return world.bodies.add(body);
+}
+
+template <typename Joint> static void add_joint(world2D &world, const body2D *body1, const body2D *body2)
+{
+    typename Joint::specs spc;
+    spc.joint.bindex1 = body1->meta.index;
+    spc.joint.bindex2 = body2->meta.index;
+    spc.joint.ganchor1 = body1->centroid();
+    spc.joint.ganchor2 = body2->centroid();
+    world.joints.add<Joint>(spc);
+}
+
+// A chain of bodies of every type and shape, linked by one joint of every built-in type
+static void build_scene(simulation &sim)
+{
+    world2D &world = sim.world;
+    world.integrator.ts.value = 1.f / 120.f;
+    add_body(world, {0.f, -5.f}, body2D::btype::STATIC, false);
+
+    std::vector<body2D *> bodies;
+    for (std::size_t i = 0; i < 9; i++)
+    {
+        const body2D::btype type = i == 4 ? body2D::btype::KINEMATIC : body2D::btype::DYNAMIC;
+        bodies.push_back(add_body(world, {2.f * static_cast<float>(i), static_cast<float>(i % 3)}, type, i % 2 == 0));
+    }
+    sim.color(world.colliders[1], lynx::color::red);
+
+    add_joint<spring_joint2D>(world, bodies[0], bodies[1]);
+    add_joint<distance_joint2D>(world, bodies[1], bodies[2]);
+    add_joint<prismatic_joint2D>(world, bodies[2], bodies[3]);
+    add_joint<revolute_joint2D>(world, bodies[3], bodies[4]);
+    add_joint<weld_joint2D>(world, bodies[4], bodies[5]);
+    add_joint<rotor_joint2D>(world, bodies[5], bodies[6]);
+    add_joint<motor_joint2D>(world, bodies[6], bodies[7]);
+    add_joint<ball_joint2D>(world, bodies[7], bodies[8]);
+}
+
+template <typename T> static bool same_records(const std::vector<T> &records1, const std::vector<T> &records2)
+{
+    return records1.size() == records2.size() &&
+           (records1.empty() || std::memcmp(records1.data(), records2.data(), records1.size() * sizeof(T)) == 0);
+}
+
+PPX_TEST(binary_snapshot_captures_every_joint_type)
+{
+    simulation sim{test_specs()};
+    build_scene(sim);
+
+    const binary_snapshot::contents cnt = binary_snapshot::capture(sim, {});
+    PPX_CHECK(cnt.bodies.size() == 10);
+    PPX_CHECK(cnt.joint_count() == 8);
+    cnt.for_each_joint_table([](const auto &table) { PPX_CHECK(table.records.size() == 1); });
+}
+
+PPX_TEST(binary_snapshot_round_trips_through_a_world)
+{
+    simulation sim1{test_specs()};
+    build_scene(sim1);
+    binary_snapshot::view_state view1;
+    view1.camera_position = {3.f, -2.f};
+    view1.framerate = 144;
+    const std::vector<std::byte> data1 = binary_snapshot::write(sim1, view1);
+
+    simulation sim2{test_specs()};
+    binary_snapshot::view_state view2;
+    PPX_CHECK(binary_snapshot::read(data1, sim2, view2));
+    PPX_CHECK(sim2.world.bodies.size() == sim1.world.bodies.size());
+    PPX_CHECK(sim2.world.integrator.ts.value == sim1.world.integrator.ts.value);
+    PPX_CHECK(view2.camera_position == view1.camera_position);
+    PPX_CHECK(view2.framerate == view1.framerate);
+
+    const std::vector<std::byte> data2 = binary_snapshot::write(sim2, view2);
+    binary_snapshot::contents cnt1;
+    binary_snapshot::contents cnt2;
+    PPX_CHECK(binary_snapshot::parse(data1, cnt1));
+    PPX_CHECK(binary_snapshot::parse(data2, cnt2));
+    PPX_CHECK(data1.size() == data2.size());
+    PPX_CHECK(same_records(cnt1.bodies, cnt2.bodies));
+    PPX_CHECK(same_records(cnt1.colliders, cnt2.colliders));
+    PPX_CHECK(same_records(cnt1.vertices, cnt2.vertices));
+    PPX_CHECK(cnt1.engine == cnt2.engine);
+
+    // Joint properties may have padding, so joints are compared through their YAML encoding below
+    PPX_CHECK(cnt1.joint_count() == cnt2.joint_count());
+#ifdef KIT_USE_YAML_CPP
+    PPX_CHECK(YAML::Dump(binary_snapshot::to_yaml(data1)) == YAML::Dump(binary_snapshot::to_yaml(data2)));
+#endif
+}
+
+#ifdef KIT_USE_YAML_CPP
+PPX_TEST(binary_snapshot_round_trips_through_yaml)
+{
+    simulation sim{test_specs()};
+    build_scene(sim);
+    const YAML::Node node1 = binary_snapshot::to_yaml(binary_snapshot::write(sim, {}));
+    PPX_CHECK(node1.IsMap());
+
+    std::vector<std::byte> data;
+    PPX_CHECK(binary_snapshot::from_yaml(node1, data));
+    const YAML::Node node2 = binary_snapshot::to_yaml(data);
+    PPX_CHECK(YAML::Dump(node1) == YAML::Dump(node2));
+}
+
+PPX_TEST(binary_snapshot_to_yaml_leaves_shared_colors)
+{
+    simulation sim{test_specs()};
+    build_scene(sim);
+    binary_snapshot::contents cnt = binary_snapshot::capture(sim, {});
+    const glm::vec4 shared = simulation::collider_color.rgba;
+    const glm::vec4 stored = glm::vec4{1.f} - shared;
+    for (glm::length_t i = 0; i < 4; i++)
+        cnt.app.collider_color[i] = stored[i];
+
+    const YAML::Node node = binary_snapshot::to_yaml(cnt);
+    PPX_CHECK(node["Collider color"].as<lynx::color>().rgba == stored);
+    PPX_CHECK(simulation::collider_color.rgba == shared);
+}
+#endif
+
+// Packs the contents of a valid snapshot after letting the caller corrupt them
+template <typename F> static std::vector<std::byte> corrupted(F &&corrupt)
+{
+    simulation sim{test_specs()};
+    build_scene(sim);
+    binary_snapshot::contents cnt = binary_snapshot::capture(sim, {});
+    corrupt(cnt);
+    return binary_snapshot::pack(cnt);
+}
+
+PPX_TEST(binary_snapshot_rejects_invalid_records)
+{
+    binary_snapshot::contents cnt;
+    PPX_CHECK(binary_snapshot::parse(corrupted([](binary_snapshot::contents &) {}), cnt));
+
+    PPX_CHECK(!binary_snapshot::parse(corrupted([](binary_snapshot::contents &c) { c.bodies[0].type = 7; }), cnt));
+    PPX_CHECK(!binary_snapshot::parse(corrupted([](binary_snapshot::contents &c) { c.colliders[0].shape = 9; }), cnt));
+    PPX_CHECK(!binary_snapshot::parse(corrupted([](binary_snapshot::contents &c) {
+                                          for (binary_snapshot::collider_record &crecord : c.colliders)
+                                              if (crecord.vertex_count > 0)
+                                                  crecord.vertex_count = 2;
+                                      }),
+                                      cnt));
+    PPX_CHECK(!binary_snapshot::parse(corrupted([](binary_snapshot::contents &c) {
+                                          std::get<0>(c.joints).records[0].joint.body2 =
+                                              static_cast<std::uint32_t>(c.bodies.size());
+                                      }),
+                                      cnt));
+}
+
+PPX_TEST(binary_snapshot_rejects_other_versions_and_unknown_sections)
+{
+    simulation sim{test_specs()};
+    build_scene(sim);
+    const std::vector<std::byte> data = binary_snapshot::write(sim, {});
+    binary_snapshot::contents cnt;
+
+    std::vector<std::byte> old_version = data;
+    const std::uint32_t version = binary_snapshot::version - 1;
+    std::memcpy(old_version.data() + offsetof(binary_snapshot::header, version), &version, sizeof(version));
+    PPX_CHECK(!binary_snapshot::parse(old_version, cnt));
+
+    // The engine section is the last one, and nothing requires it
+    binary_snapshot::header hdr;
+    std::memcpy(&hdr, data.data(), sizeof(hdr));
+    std::vector<std::byte> unknown_section = data;
+    const std::uint32_t id = static_cast<std::uint32_t>(binary_snapshot::section_id::ENGINE) + 1;
+    const std::size_t last = sizeof(hdr) + (hdr.section_count - 1) * sizeof(binary_snapshot::section);
+    std::memcpy(unknown_section.data() + last + offsetof(binary_snapshot::section, id), &id, sizeof(id));
+    PPX_CHECK(!binary_snapshot::parse(unknown_section, cnt));
+}
+} // namespace ppx::test
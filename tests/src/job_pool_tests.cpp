@@ -0,0 +1,55 @@
+#include "test.hpp"
+
+#include "ppx-app/threading/job_pool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace ppx::test
+{
+PPX_TEST(job_pool_parallel_for_covers_every_index_once)
+{
+    for (const std::size_t threads : {0, 1, 3})
+    {
+        job_pool jobs{threads};
+        std::vector<std::atomic<std::uint32_t>> visits(10000);
+        jobs.parallel_for(
+            0, visits.size(),
+            [&visits](const std::size_t start, const std::size_t end) {
+                for (std::size_t i = start; i < end; i++)
+                    visits[i]++;
+            },
+            64);
+        for (const std::atomic<std::uint32_t> &count : visits)
+            PPX_CHECK(count == 1);
+    }
+}
+
+PPX_TEST(job_pool_parallel_for_rethrows_on_the_caller)
+{
+    for (const std::size_t threads : {0, 1, 3})
+    {
+        job_pool jobs{threads};
+        std::atomic<std::size_t> ran{0};
+        bool caught = false;
+        try
+        {
+            jobs.parallel_for(
+                0, 1000,
+                [&ran](const std::size_t start, const std::size_t end) {
+                    ran += end - start;
+                    if (start == 500)
+                        throw std::runtime_error("chunk failed");
+                },
+                10);
+        }
+        catch (const std::runtime_error &)
+        {
+            caught = true;
+        }
+        // Chunks that did not throw still run, and the call only returns once all of them are done
+        PPX_CHECK(caught);
+        PPX_CHECK(ran == 1000);
+    }
+}
+} // namespace ppx::test
@@ -0,0 +1,52 @@
+#include "test.hpp"
+
+#include <exception>
+#include <iostream>
+#include <string_view>
+
+namespace ppx::test
+{
+std::vector<test_case> &registry()
+{
+    static std::vector<test_case> tests;
+    return tests;
+}
+
+void fail(const char *expression, const char *file, const int line)
+{
+    throw failure{std::string(file) + ":" + std::to_string(line) + ": check failed: " + expression};
+}
+} // namespace ppx::test
+
+// Runs every test whose name contains the first argument, or all of them, and exits with the amount of failures
+int main(int argc, char **argv)
+{
+    using namespace ppx::test;
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+
+    std::size_t run = 0;
+    int failed = 0;
+    for (const test_case &test : registry())
+    {
+        if (std::string_view{test.name}.find(filter) == std::string_view::npos)
+            continue;
+        run++;
+        try
+        {
+            test.run();
+            std::cout << "[PASS] " << test.name << '\n';
+        }
+        catch (const failure &f)
+        {
+            std::cout << "[FAIL] " << test.name << "\n       " << f.message << '\n';
+            failed++;
+        }
+        catch (const std::exception &e)
+        {
+            std::cout << "[FAIL] " << test.name << "\n       unexpected exception: " << e.what() << '\n';
+            failed++;
+        }
+    }
+    std::cout << run - static_cast<std::size_t>(failed) << '/' << run << " tests passed\n";
+    return failed;
+}
@@ -0,0 +1,71 @@
+#include "test.hpp"
+
+#include "ppx-app/app/simulation.hpp"
+
+namespace ppx::test
+{
+// A unit circle at the origin, overlapped by a later 2x2 box centered at (0.5, 0)
+static void build_picking_scene(simulation &sim)
+{
+    specs::collider2D circle;
+    circle.props.shape = collider2D::stype::CIRCLE;
+    circle.props.radius = 1.f;
+    specs::body2D body1;
+    body1.type = body2D::btype::STATIC;
+    body1.props.colliders.push_back(circle);
+    sim.world.bodies.add(body1);
+
+    specs::collider2D box;
+    box.props.vertices = polygon::square(2.f);
+    specs::body2D body2;
+    body2.position = {0.5f, 0.f};
+    body2.type = body2D::btype::STATIC;
+    body2.props.colliders.push_back(box);
+    sim.world.bodies.add(body2);
+
+    // Refreshes the collider representations the picking grid is built from
+    sim.paused = true;
+    sim.on_update(1.f / 60.f);
+}
+
+PPX_TEST(picking_prefers_the_latest_collider_and_tests_exact_shapes)
+{
+    simulation::specs spc;
+    spc.worker_threads = 1;
+    simulation sim{spc};
+    build_picking_scene(sim);
+    const collider2D *circle = sim.world.colliders[0];
+    const collider2D *box = sim.world.colliders[1];
+
+    PPX_CHECK(sim.collider_at({0.8f, 0.f}) == box);
+    PPX_CHECK(sim.collider_at({-0.9f, 0.f}) == circle);
+    PPX_CHECK(sim.collider_at({1.2f, 0.9f}) == box);
+    // Inside the circle's bounding box, but outside both shapes
+    PPX_CHECK(sim.collider_at({-0.9f, 0.9f}) == nullptr);
+    PPX_CHECK(sim.collider_at({10.f, 10.f}) == nullptr);
+
+    std::vector<collider2D *> colliders;
+    sim.colliders_at({0.f, 0.f}, colliders);
+    PPX_CHECK(colliders.size() == 2);
+    sim.colliders_at({-0.9f, 0.9f}, colliders);
+    PPX_CHECK(colliders.empty());
+}
+
+PPX_TEST(picking_areas_test_bounding_boxes)
+{
+    simulation::specs spc;
+    spc.worker_threads = 1;
+    simulation sim{spc};
+    build_picking_scene(sim);
+
+    std::vector<collider2D *> colliders;
+    sim.colliders_in({glm::vec2{-3.f}, glm::vec2{3.f}}, colliders, true);
+    PPX_CHECK(colliders.size() == 2);
+
+    const bounds2D left{{-1.2f, -1.2f}, {0.f, 1.2f}};
+    sim.colliders_in(left, colliders);
+    PPX_CHECK(colliders.size() == 2);
+    sim.colliders_in(left, colliders, true);
+    PPX_CHECK(colliders.empty());
+}
+} // namespace ppx::test
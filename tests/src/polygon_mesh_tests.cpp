@@ -0,0 +1,52 @@
+#include "test.hpp"
+
+#include "ppx-app/drawables/shapes/polygon_mesh.hpp"
+
+namespace ppx::test
+{
+PPX_TEST(polygon_mesh_cache_shares_meshes_with_equal_vertices)
+{
+    const std::vector<glm::vec2> box{{-1.f, -1.f}, {1.f, -1.f}, {1.f, 1.f}, {-1.f, 1.f}};
+    const std::vector<glm::vec2> triangle{{0.f, 0.f}, {1.f, 0.f}, {0.f, 1.f}};
+
+    polygon_mesh_cache cache;
+    std::vector<polygon_mesh_cache::handle> handles;
+    for (std::size_t i = 0; i < 100; i++)
+        handles.push_back(cache.acquire(box.begin(), box.end()));
+    handles.push_back(cache.acquire(triangle.begin(), triangle.end()));
+
+    PPX_CHECK(cache.size() == 2);
+    PPX_CHECK(cache.references() == 101);
+    PPX_CHECK(handles[0].id() == handles[99].id());
+    PPX_CHECK(handles[0].id() != handles[100].id());
+    PPX_CHECK(handles[0].mesh().vertices == box);
+    PPX_CHECK(cache.memory() >= (box.size() + triangle.size()) * sizeof(glm::vec2));
+}
+
+PPX_TEST(polygon_mesh_cache_frees_meshes_with_their_last_handle)
+{
+    const std::vector<glm::vec2> box{{-1.f, -1.f}, {1.f, -1.f}, {1.f, 1.f}, {-1.f, 1.f}};
+    const std::vector<glm::vec2> triangle{{0.f, 0.f}, {1.f, 0.f}, {0.f, 1.f}};
+
+    polygon_mesh_cache cache;
+    std::vector<polygon_mesh_cache::handle> handles;
+    for (std::size_t i = 0; i < 10; i++)
+        handles.push_back(cache.acquire(box.begin(), box.end()));
+    handles.push_back(cache.acquire(triangle.begin(), triangle.end()));
+
+    handles.erase(handles.begin(), handles.begin() + 5);
+    PPX_CHECK(cache.size() == 2);
+    PPX_CHECK(cache.references() == 6);
+
+    handles.pop_back();
+    PPX_CHECK(cache.size() == 1);
+
+    // Moved from handles no longer hold a reference
+    polygon_mesh_cache::handle moved = std::move(handles.front());
+    handles.clear();
+    PPX_CHECK(cache.references() == 1);
+    moved = {};
+    PPX_CHECK(cache.size() == 0);
+    PPX_CHECK(cache.references() == 0);
+}
+} // namespace ppx::test
@@ -0,0 +1,116 @@
+#include "test.hpp"
+
+#include "ppx-app/app/simulation.hpp"
+#include "ppx-app/replay/replay_recorder.hpp"
+#include "ppx-app/replay/replay_player.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <cmath>
+#include <filesystem>
+
+namespace ppx::test
+{
+static constexpr std::size_t replay_frames = 300;
+static constexpr std::size_t replay_colliders = 120;
+
+// Deterministic motion with every case the codec handles: sleeping colliders that keep still, small deltas, a jump too
+// large for a delta, rotations wrapping around and a collider added midway
+static std::vector<world_snapshot> replay_scene()
+{
+    std::vector<world_snapshot> frames(replay_frames);
+    world_snapshot snapshot;
+    snapshot.colliders.resize(replay_colliders);
+    snapshot.springs.resize(8);
+    for (std::size_t i = 0; i < replay_colliders; i++)
+    {
+        const float angle = static_cast<float>(i);
+        snapshot.colliders[i].position = 40.f * glm::vec2{std::sin(angle), std::cos(angle)};
+    }
+
+    for (std::size_t f = 0; f < replay_frames; f++)
+    {
+        for (std::size_t i = 0; i < snapshot.colliders.size(); i++)
+        {
+            collider_state &state = snapshot.colliders[i];
+            state.asleep = i % 3 == 0;
+            if (state.asleep)
+                continue;
+            const float t = static_cast<float>(f + i);
+            state.position += 0.1f * glm::vec2{std::sin(t), std::cos(1.3f * t)};
+            if (f == 150 && i == 5)
+                state.position.x += 100.f;
+            state.rotation += 0.3f;
+            if (state.rotation > glm::pi<float>())
+                state.rotation -= 2.f * glm::pi<float>();
+        }
+        for (joint_state &spring : snapshot.springs)
+        {
+            spring.anchor1 += glm::vec2{0.01f, 0.f};
+            spring.value = std::sin(static_cast<float>(f));
+        }
+        if (f == 200)
+            snapshot.colliders.push_back(snapshot.colliders[1]);
+        frames[f] = snapshot;
+    }
+    return frames;
+}
+
+static bool matches(const world_snapshot &decoded, const world_snapshot &expected)
+{
+    constexpr float tolerance = 1e-3f;
+    if (decoded.colliders.size() != expected.colliders.size() || decoded.springs.size() != expected.springs.size())
+        return false;
+    for (std::size_t i = 0; i < decoded.colliders.size(); i++)
+    {
+        const collider_state &a = decoded.colliders[i];
+        const collider_state &b = expected.colliders[i];
+        const float rotation = std::remainder(a.rotation - b.rotation, 2.f * glm::pi<float>());
+        if (a.asleep != b.asleep || glm::length(a.position - b.position) > tolerance || std::abs(rotation) > tolerance)
+            return false;
+    }
+    for (std::size_t i = 0; i < decoded.springs.size(); i++)
+        if (glm::length(decoded.springs[i].anchor1 - expected.springs[i].anchor1) > tolerance ||
+            std::abs(decoded.springs[i].value - expected.springs[i].value) > tolerance)
+            return false;
+    return true;
+}
+
+PPX_TEST(replay_round_trips_sequentially_and_by_seeking)
+{
+    const std::vector<world_snapshot> frames = replay_scene();
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ppx-app-replay-test.ppxr";
+
+    replay_recorder recorder;
+    replay_recorder::specs spc;
+    spc.keyframe_interval = 60;
+    PPX_CHECK(recorder.open(path, spc));
+    for (const world_snapshot &frame : frames)
+        recorder.record(frame);
+    PPX_CHECK(recorder.frame_count() == replay_frames);
+    PPX_CHECK(recorder.keyframe_count() >= replay_frames / spc.keyframe_interval);
+    recorder.close();
+
+    // Joint tracks are matched against the world's joint managers, which a simulation's world has
+    simulation sim;
+    replay_player player;
+    PPX_CHECK(player.open(path));
+    PPX_CHECK(player.frame_count() == replay_frames);
+
+    world_snapshot decoded;
+    for (std::size_t f = 0; f < replay_frames; f++)
+    {
+        PPX_CHECK(player.advance());
+        player.fill(sim.world, decoded);
+        PPX_CHECK(matches(decoded, frames[f]));
+    }
+    for (const std::uint64_t f : {299, 3, 150, 149, 200, 201, 0, 123, 124, 60, 59})
+    {
+        PPX_CHECK(player.seek(f));
+        player.fill(sim.world, decoded);
+        PPX_CHECK(matches(decoded, frames[f]));
+    }
+    player.close();
+    std::filesystem::remove(path);
+}
+} // namespace ppx::test
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ppx::test
+{
+struct test_case
+{
+    const char *name;
+    void (*run)();
+};
+
+std::vector<test_case> &registry();
+
+struct registrar
+{
+    registrar(const char *name, void (*run)())
+    {
+        registry().push_back({name, run});
+    }
+};
+
+// Thrown by a failed check, ending the test case it belongs to
+struct failure
+{
+    std::string message;
+};
+
+[[noreturn]] void fail(const char *expression, const char *file, int line);
+} // namespace ppx::test
+
+#define PPX_TEST(name)                                                                                                 \
+    static void name();                                                                                                \
+    static const ppx::test::registrar name##_registrar{#name, name};                                                   \
+    static void name()
+
+#define PPX_CHECK(expression)                                                                                          \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expression))                                                                                             \
+            ppx::test::fail(#expression, __FILE__, __LINE__);                                                          \
+    } while (false)
@@ -0,0 +1,107 @@
+#include "test.hpp"
+
+#include "ppx-app/profiling/world_telemetry.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace ppx::test
+{
+// A reader polling while the writer laps the ring many times must never see a torn or reordered sample. The timestep is
+// set to the step number before sampling, so a sample mixing two writes shows up as a mismatch
+PPX_TEST(world_telemetry_readers_never_see_torn_samples)
+{
+    job_pool jobs{1};
+    world2D world{specs::world2D{}};
+    for (std::size_t i = 0; i < 64; i++)
+    {
+        specs::collider2D collider;
+        collider.props.shape = collider2D::stype::CIRCLE;
+        collider.props.radius = 0.25f;
+
+        specs::body2D body;
+        body.position = {static_cast<float>(i), 0.f};
+        body.props.colliders.push_back(collider);
+        body.velocity = {1.f, 0.f};
+        world.bodies.add(body);
+    }
+
+    world_telemetry telemetry;
+    constexpr std::size_t steps = 5 * world_telemetry::capacity;
+    std::atomic<bool> done{false};
+    std::thread writer{[&]() {
+        for (std::size_t i = 0; i < steps; i++)
+        {
+            world.integrator.ts.value = static_cast<float>(i);
+            telemetry.sample(world, jobs, kit::perf::time{});
+        }
+        done = true;
+    }};
+
+    std::vector<telemetry_sample> samples;
+    bool ordered = true;
+    bool consistent = true;
+    while (!done)
+    {
+        telemetry.read(samples);
+        for (std::size_t i = 0; i < samples.size(); i++)
+        {
+            consistent = consistent && samples[i].bodies == 64 &&
+                         samples[i].timestep == static_cast<float>(samples[i].step);
+            ordered = ordered && (i == 0 || samples[i].step > samples[i - 1].step);
+        }
+    }
+    writer.join();
+    PPX_CHECK(ordered);
+    PPX_CHECK(consistent);
+
+    telemetry.read(samples);
+    PPX_CHECK(telemetry.total_samples() == steps);
+    PPX_CHECK(samples.size() == world_telemetry::capacity);
+    for (std::size_t i = 1; i < samples.size(); i++)
+        PPX_CHECK(samples[i].step == samples[i - 1].step + 1);
+}
+
+PPX_TEST(world_telemetry_honors_the_sampling_interval)
+{
+    job_pool jobs{1};
+    world2D world{specs::world2D{}};
+    world_telemetry telemetry;
+    telemetry.interval = 4;
+    for (std::size_t i = 0; i < 100; i++)
+        telemetry.sample(world, jobs, kit::perf::time{});
+    PPX_CHECK(telemetry.total_samples() == 25);
+
+    telemetry.enabled = false;
+    telemetry.sample(world, jobs, kit::perf::time{});
+    PPX_CHECK(telemetry.total_samples() == 25);
+}
+
+PPX_TEST(world_telemetry_serial_and_pooled_reductions_match)
+{
+    job_pool jobs{4};
+    world2D world{specs::world2D{}};
+    for (std::size_t i = 0; i < 100; i++)
+    {
+        specs::body2D body;
+        body.position = {static_cast<float>(i), 0.f};
+        body.velocity = {static_cast<float>(i % 7), 1.f};
+        world.bodies.add(body);
+    }
+
+    world_telemetry pooled;
+    world_telemetry serial;
+    pooled.grain = 8;
+    serial.grain = 8;
+    pooled.sample(world, jobs, kit::perf::time{});
+    serial.sample(world, kit::perf::time{});
+
+    std::vector<telemetry_sample> a;
+    std::vector<telemetry_sample> b;
+    pooled.read(a);
+    serial.read(b);
+    PPX_CHECK(a.size() == 1 && b.size() == 1);
+    PPX_CHECK(a[0].kinetic_energy == b[0].kinetic_energy);
+    PPX_CHECK(a[0].sleeping_bodies == b[0].sleeping_bodies);
+}
+} // namespace ppx::test